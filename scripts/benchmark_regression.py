@@ -0,0 +1,92 @@
+import duckdb
+import argparse
+import os
+import sys
+
+### Parse script parameters
+parser = argparse.ArgumentParser(description='Compare the Delta overhead over plain parquet against a stored baseline')
+parser.add_argument('-r', '--results-dir', help='Directory containing the benchmark result csv files', required=False, default='benchmark_results')
+parser.add_argument('-i', '--io-mode', help='IO mode the benchmarks were run with (local or remote)', required=False, default='local')
+parser.add_argument('-b', '--baseline', help='Baseline csv file, defaults to benchmark/regression/tpcds_sf1_<io_mode>.csv', required=False, default=None)
+parser.add_argument('-v', '--variants', help='Comma separated list of delta variants to compare to parquet', required=False, default='delta,delta-attach,delta-attach-pin')
+parser.add_argument('--max-regression', help='Maximum allowed relative increase of the overhead ratio of a query over the baseline', required=False, type=float, default=0.25)
+parser.add_argument('--max-total-regression', help='Maximum allowed relative increase of the geometric mean overhead ratio of a variant over the baseline', required=False, type=float, default=0.05)
+parser.add_argument('--min-timing', help='Queries where parquet runs faster than this (in seconds) are too noisy to check individually', required=False, type=float, default=0.05)
+parser.add_argument('-u', '--update-baseline', help='Store the current overhead ratios as the new baseline', required=False, action='store_true')
+args = parser.parse_args()
+
+baseline_path = args.baseline or f'benchmark/regression/tpcds_sf1_{args.io_mode}.csv'
+variants = args.variants.split(',')
+
+### Compute the overhead ratio per variant and query
+con = duckdb.connect()
+
+def load_variant(variant):
+    path = os.path.join(args.results_dir, f'tpcds-sf1-{variant}-{args.io_mode}.csv')
+    if not os.path.exists(path):
+        sys.exit(f"Missing benchmark results '{path}', run `make bench-run-tpcds-sf1-{variant}` first")
+    con.execute(f"""
+        CREATE OR REPLACE TABLE "{variant}" AS
+        SELECT parse_filename(name, true) as query, median(timing) as timing
+        FROM read_csv('{path}', columns = {{'name': 'VARCHAR', 'run': 'BIGINT', 'timing': 'DOUBLE'}})
+        GROUP BY query
+    """)
+
+load_variant('parquet')
+for variant in variants:
+    load_variant(variant)
+
+con.execute("CREATE TABLE overhead (variant VARCHAR, query VARCHAR, parquet_timing DOUBLE, timing DOUBLE, ratio DOUBLE)")
+for variant in variants:
+    con.execute(f"""
+        INSERT INTO overhead
+        SELECT '{variant}', v.query, p.timing, v.timing, v.timing / p.timing
+        FROM "{variant}" v JOIN parquet p USING (query)
+    """)
+
+if args.update_baseline:
+    os.makedirs(os.path.dirname(baseline_path), exist_ok=True)
+    con.execute(f"COPY (SELECT variant, query, ratio FROM overhead ORDER BY ALL) TO '{baseline_path}' (HEADER)")
+    print(f"Stored the overhead ratios of {len(variants)} variants as baseline in '{baseline_path}'")
+    sys.exit(0)
+
+if not os.path.exists(baseline_path):
+    sys.exit(f"Missing baseline '{baseline_path}', create it with `make bench-regression-update-baseline`")
+
+con.execute(f"CREATE TABLE baseline AS FROM read_csv('{baseline_path}', columns = {{'variant': 'VARCHAR', 'query': 'VARCHAR', 'ratio': 'DOUBLE'}})")
+
+### Compare against the baseline
+failed = False
+
+per_variant = con.execute("""
+    SELECT o.variant, exp(avg(ln(o.ratio))) as ratio, exp(avg(ln(b.ratio))) as baseline_ratio
+    FROM overhead o JOIN baseline b USING (variant, query)
+    GROUP BY ALL
+    ORDER BY ALL
+""").fetchall()
+print(f"{'variant':>20} {'overhead':>10} {'baseline':>10} {'change':>8}")
+for variant, ratio, baseline_ratio in per_variant:
+    change = ratio / baseline_ratio - 1
+    status = ''
+    if change > args.max_total_regression:
+        failed = True
+        status = 'FAIL'
+    print(f"{variant:>20} {ratio:10.3f} {baseline_ratio:10.3f} {change * 100:7.1f}% {status}")
+
+per_query = con.execute(f"""
+    SELECT o.variant, o.query, o.ratio, b.ratio as baseline_ratio
+    FROM overhead o JOIN baseline b USING (variant, query)
+    WHERE o.parquet_timing >= {args.min_timing} AND o.ratio / b.ratio - 1 > {args.max_regression}
+    ORDER BY ALL
+""").fetchall()
+if len(per_query) > 0:
+    failed = True
+    print(f"\nQueries with an overhead regression over {args.max_regression * 100:.0f}%:")
+    for variant, query, ratio, baseline_ratio in per_query:
+        print(f"{variant:>20} {query:>6} {ratio:10.3f} (baseline {baseline_ratio:.3f})")
+
+missing = con.execute("SELECT variant, query FROM baseline EXCEPT SELECT variant, query FROM overhead ORDER BY ALL").fetchall()
+if len(missing) > 0:
+    print(f"\nWarning: {len(missing)} baseline queries have no results, e.g. {missing[0][0]} {missing[0][1]}")
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,102 @@
+import duckdb
+import argparse
+import os
+import random
+import threading
+import time
+
+### Parse script parameters
+parser = argparse.ArgumentParser(description='Run short filtered queries from N concurrent connections against an ATTACHed delta table')
+parser.add_argument('-e', '--extension', help='Path to the delta extension binary', required=False, default='./build/release/extension/delta/delta.duckdb_extension')
+parser.add_argument('-t', '--table', help='Path of the delta table to attach (generated with delta_generate if it does not exist)', required=False, default='./data/generated/concurrency/delta_lake')
+parser.add_argument('-c', '--connections', help='Comma separated list of connection counts to run', required=False, default='1,2,4,8,16,32')
+parser.add_argument('-m', '--modes', help='Comma separated list of attach modes to run (pinned, unpinned)', required=False, default='pinned,unpinned')
+parser.add_argument('-d', '--duration', help='Duration of each measurement in seconds', required=False, type=float, default=10)
+parser.add_argument('-w', '--warmup', help='Warmup duration of each measurement in seconds', required=False, type=float, default=2)
+parser.add_argument('-q', '--query', help='Query to run, {table} and {key} are substituted', required=False, default='SELECT count(*) FROM {table} WHERE part = {key} AND id < 1000000')
+parser.add_argument('-k', '--keys', help='Keys are drawn uniformly from [0, keys)', required=False, type=int, default=10)
+parser.add_argument('--threads-per-query', help='Value of the threads setting for each connection', required=False, type=int, default=1)
+parser.add_argument('-o', '--output', help='CSV file to write the results to', required=False, default='benchmark_results/concurrency/concurrency.csv')
+args = parser.parse_args()
+
+def create_database():
+    con = duckdb.connect(config={'allow_unsigned_extensions': 'true'})
+    con.execute(f"LOAD '{args.extension}'")
+    if not os.path.isdir(os.path.join(args.table, '_delta_log')):
+        print(f"Generating delta table at '{args.table}'")
+        con.execute(f"CALL delta_generate('{args.table}', files := 100, commits := 10, partitions := 10, rows_per_file := 10000)")
+    return con
+
+def percentile(sorted_values, pct):
+    if len(sorted_values) == 0:
+        return float('nan')
+    index = min(len(sorted_values) - 1, int(round(pct / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+def run_worker(cursor, table, start_measuring, stop, latencies, errors):
+    rng = random.Random()
+    while not stop.is_set():
+        query = args.query.format(table=table, key=rng.randrange(args.keys))
+        start = time.perf_counter()
+        try:
+            cursor.execute(query).fetchall()
+        except Exception as e:
+            errors.append(str(e))
+            continue
+        end = time.perf_counter()
+        if start >= start_measuring[0]:
+            latencies.append(end - start)
+
+def run_measurement(con, table, connections):
+    cursors = []
+    for _ in range(connections):
+        cursor = con.cursor()
+        cursor.execute(f"SET threads={args.threads_per_query}")
+        cursors.append(cursor)
+
+    stop = threading.Event()
+    start_measuring = [time.perf_counter() + args.warmup]
+    latencies = [[] for _ in range(connections)]
+    errors = []
+    workers = [threading.Thread(target=run_worker, args=(cursors[i], table, start_measuring, stop, latencies[i], errors)) for i in range(connections)]
+    for worker in workers:
+        worker.start()
+    time.sleep(args.warmup + args.duration)
+    stop.set()
+    for worker in workers:
+        worker.join()
+    for cursor in cursors:
+        cursor.close()
+
+    if len(errors) > 0:
+        raise Exception(f"{len(errors)} queries failed, first error: {errors[0]}")
+
+    all_latencies = sorted([latency for worker_latencies in latencies for latency in worker_latencies])
+    return {
+        'queries': len(all_latencies),
+        'throughput': len(all_latencies) / args.duration,
+        'p50_ms': percentile(all_latencies, 50) * 1000,
+        'p99_ms': percentile(all_latencies, 99) * 1000,
+    }
+
+### Run the benchmark
+con = create_database()
+results = []
+for mode in args.modes.split(','):
+    table = f'concurrency_{mode}'
+    options = '(TYPE delta, PIN_SNAPSHOT)' if mode == 'pinned' else '(TYPE delta)'
+    con.execute(f"ATTACH '{args.table}' AS {table} {options}")
+    for connections in [int(c) for c in args.connections.split(',')]:
+        result = run_measurement(con, table, connections)
+        result['mode'] = mode
+        result['connections'] = connections
+        results.append(result)
+        print(f"{mode:>10} {connections:>4} connections: {result['throughput']:10.1f} queries/s, p50 {result['p50_ms']:8.2f} ms, p99 {result['p99_ms']:8.2f} ms")
+    con.execute(f"DETACH {table}")
+
+### Write results
+os.makedirs(os.path.dirname(args.output), exist_ok=True)
+with open(args.output, 'w') as f:
+    f.write('mode,connections,queries,throughput,p50_ms,p99_ms\n')
+    for result in results:
+        f.write(f"{result['mode']},{result['connections']},{result['queries']},{result['throughput']},{result['p50_ms']},{result['p99_ms']}\n")
@@ -102,6 +102,10 @@ generate_test_data_delta_rs(BASE_PATH,"simple_blob_table", query, "blob_part", a
 query = "CREATE table test_table AS SELECT {'i':i, 'j':i+1} as value, i%2 as part from range(0,10) tbl(i);"
 generate_test_data_delta_rs(BASE_PATH,"simple_partitioned_with_structs", query, "part")
 
+## Simple table with a column named filename, the default name of the column added by the filename option
+query = "CREATE table test_table AS SELECT i as id, 'file' || i::VARCHAR as filename from range(0,10) tbl(i);"
+generate_test_data_delta_rs(BASE_PATH,"simple_filename_column", query, add_golden_table=False)
+
 ################################################
 ### Deletion vectors
 ################################################
@@ -158,6 +162,15 @@ queries = [
 ]
 generate_test_data_pyspark_by_queries(BASE_PATH,'evolution_type_widening', 'evolution_type_widening', base_query, queries)
 
+## CREATE table that widens an INT column to BIGINT, the files written before the widening still store INT32
+base_query = "select CAST(id AS INT) as a, CAST(2147483647 - id AS INT) as b from range(0, 10) t(id)"
+queries = [
+    "ALTER TABLE evolution_type_widening_int_to_bigint ALTER COLUMN a TYPE BIGINT;",
+    "ALTER TABLE evolution_type_widening_int_to_bigint ALTER COLUMN b TYPE BIGINT;",
+    "INSERT INTO evolution_type_widening_int_to_bigint VALUES (10, 2147483648), (11, 4294967296);",
+]
+generate_test_data_pyspark_by_queries(BASE_PATH,'evolution_type_widening_int_to_bigint', 'evolution_type_widening_int_to_bigint', base_query, queries)
+
 ## CREATE table that has struct widening
 base_query = "select named_struct('struct_field_a', 'value1', 'struct_field_b', 'value2') as top_level_column;"
 queries = [
@@ -173,3 +186,16 @@ queries = [
     "INSERT INTO evolution_struct_field_modification_nested VALUES (named_struct('top_level_struct', named_struct('struct_field_a', 'value3', 'struct_field_b', 'value4', 'struct_field_c', 'value5')));",
 ]
 generate_test_data_pyspark_by_queries(BASE_PATH,'evolution_struct_field_modification_nested', 'evolution_struct_field_modification_nested', base_query, queries)
+
+## CREATE table with column mapping mode 'id' that renames and drops columns, including fields of structs nested in lists
+## and maps, so that the files can only be read correctly by field id
+base_query = "select CAST(1 AS INT) as a, 'value1' as b, array(named_struct('x', 1, 'y', 'y1')) as list_column, map('k1', named_struct('x', 1, 'y', 'y1')) as map_column;"
+queries = [
+    "ALTER TABLE evolution_column_mapping_id RENAME COLUMN a TO a_renamed;",
+    "ALTER TABLE evolution_column_mapping_id DROP COLUMN b;",
+    "ALTER TABLE evolution_column_mapping_id ADD COLUMN b BIGINT;",
+    "ALTER TABLE evolution_column_mapping_id RENAME COLUMN list_column.element.x TO x_renamed;",
+    "ALTER TABLE evolution_column_mapping_id RENAME COLUMN map_column.value.y TO y_renamed;",
+    "INSERT INTO evolution_column_mapping_id VALUES (2, array(named_struct('x_renamed', 2, 'y', 'y2')), map('k2', named_struct('x', 2, 'y_renamed', 'y2')), 2);",
+]
+generate_test_data_pyspark_by_queries(BASE_PATH,'evolution_column_mapping_id', 'evolution_column_mapping_id', base_query, queries, column_mapping_mode='id')
@@ -64,12 +64,13 @@ def generate_test_data_pyspark(base_path, name, current_path, input_path, delete
             shutil.rmtree(full_path)
         raise
 
-def generate_test_data_pyspark_by_queries(base_path, name, current_path, base_query, queries):
+def generate_test_data_pyspark_by_queries(base_path, name, current_path, base_query, queries, column_mapping_mode='name'):
     """
     schema_evolve_pyspark_deltatable generates some test data using pyspark and duckdb
 
     :param current_path: the test data path
     :param input_path: the path to an input parquet file
+    :param column_mapping_mode: 'name' enables column mapping after creating the table, 'id' can only be set on creation
     :return: describe what it returns
     """
 
@@ -96,9 +97,12 @@ def generate_test_data_pyspark_by_queries(base_path, name, current_path, base_qu
         ## DATA GENERATION
         # df = spark.read.parquet(input_path)
         # df.write.format("delta").mode("overwrite").save(delta_table_path)
-        spark.sql(f"CREATE TABLE {name} USING delta LOCATION '{delta_table_path}' AS {base_query}")
+        if column_mapping_mode == 'id':
+            spark.sql(f"CREATE TABLE {name} USING delta LOCATION '{delta_table_path}' TBLPROPERTIES ('delta.minReaderVersion' = '2', 'delta.minWriterVersion' = '5', 'delta.columnMapping.mode' = 'id') AS {base_query}")
+        else:
+            spark.sql(f"CREATE TABLE {name} USING delta LOCATION '{delta_table_path}' AS {base_query}")
 
-        spark.sql(f"ALTER TABLE {name} SET TBLPROPERTIES ('delta.minReaderVersion' = '2', 'delta.minWriterVersion' = '5', 'delta.columnMapping.mode' = 'name', 'delta.enableTypeWidening' = 'true');")
+            spark.sql(f"ALTER TABLE {name} SET TBLPROPERTIES ('delta.minReaderVersion' = '2', 'delta.minWriterVersion' = '5', 'delta.columnMapping.mode' = 'name', 'delta.enableTypeWidening' = 'true');")
 
         for query in queries:
             spark.sql(query)
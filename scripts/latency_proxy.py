@@ -0,0 +1,132 @@
+import argparse
+import http.client
+import json
+import random
+import threading
+import time
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+### Parse script parameters
+parser = argparse.ArgumentParser(description='S3 compatible reverse proxy that injects latency and bandwidth limits and counts requests')
+parser.add_argument('-p', '--port', help='Port to listen on', required=False, type=int, default=9010)
+parser.add_argument('-u', '--upstream', help='Upstream object store endpoint', required=False, default='http://duckdb-minio.com:9000')
+parser.add_argument('-l', '--latency-ms', help='Latency added to every request', required=False, type=float, default=50)
+parser.add_argument('-j', '--jitter-ms', help='Uniformly distributed jitter added on top of the latency', required=False, type=float, default=0)
+parser.add_argument('--tail-latency-ms', help='Latency added instead of the regular latency to a fraction of the requests, to simulate tail latency', required=False, type=float, default=0)
+parser.add_argument('--tail-probability', help='Fraction of the requests that get the tail latency', required=False, type=float, default=0)
+parser.add_argument('-b', '--bandwidth-mbps', help='Bandwidth limit per response in MB/s (0 is unlimited)', required=False, type=float, default=0)
+args = parser.parse_args()
+
+upstream = urllib.parse.urlparse(args.upstream)
+
+# Headers that apply to a single connection and must not be forwarded
+HOP_BY_HOP_HEADERS = {'connection', 'keep-alive', 'proxy-authenticate', 'proxy-authorization', 'te', 'trailers', 'transfer-encoding', 'upgrade'}
+THROTTLE_CHUNK_SIZE = 64 * 1024
+
+class RequestStats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.stats = {}
+
+    def record(self, category, nbytes):
+        with self.lock:
+            entry = self.stats.setdefault(category, {'requests': 0, 'bytes': 0})
+            entry['requests'] += 1
+            entry['bytes'] += nbytes
+
+    def reset(self):
+        with self.lock:
+            self.stats = {}
+
+    def to_json(self):
+        with self.lock:
+            return json.dumps(self.stats)
+
+stats = RequestStats()
+
+def classify(method, path):
+    parsed = urllib.parse.urlparse(path)
+    query = urllib.parse.parse_qs(parsed.query)
+    key = urllib.parse.unquote(parsed.path)
+    if method == 'HEAD':
+        return 'head'
+    if 'list-type' in query or 'prefix' in query:
+        return 'list'
+    if '/_delta_log/' in key:
+        return 'log'
+    if key.endswith('.bin'):
+        return 'dv'
+    if key.endswith('.parquet'):
+        return 'data'
+    return 'other'
+
+class ProxyHandler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, format, *args):
+        pass
+
+    def send_control_response(self, body):
+        data = body.encode()
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def handle_control(self):
+        if self.path == '/__proxy/stats':
+            self.send_control_response(stats.to_json())
+        elif self.path == '/__proxy/reset':
+            stats.reset()
+            self.send_control_response('{}')
+        else:
+            self.send_error(404)
+
+    def forward(self):
+        if self.path.startswith('/__proxy/'):
+            return self.handle_control()
+
+        content_length = int(self.headers.get('Content-Length', 0))
+        body = self.rfile.read(content_length) if content_length > 0 else None
+
+        latency_ms = args.tail_latency_ms if random.random() < args.tail_probability else args.latency_ms
+        time.sleep((latency_ms + random.uniform(0, args.jitter_ms)) / 1000.0)
+
+        # The Host header is forwarded unchanged: it is part of the request signature
+        headers = {k: v for k, v in self.headers.items() if k.lower() not in HOP_BY_HOP_HEADERS}
+        connection = http.client.HTTPConnection(upstream.hostname, upstream.port or 80)
+        connection.request(self.command, self.path, body=body, headers=headers)
+        response = connection.getresponse()
+        data = response.read() if self.command != 'HEAD' else b''
+        connection.close()
+
+        stats.record(classify(self.command, self.path), len(data))
+
+        self.send_response(response.status, response.reason)
+        for k, v in response.getheaders():
+            if k.lower() in HOP_BY_HOP_HEADERS or (k.lower() == 'content-length' and self.command != 'HEAD'):
+                continue
+            self.send_header(k, v)
+        if self.command != 'HEAD':
+            self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+
+        if args.bandwidth_mbps <= 0:
+            self.wfile.write(data)
+            return
+        for offset in range(0, len(data), THROTTLE_CHUNK_SIZE):
+            chunk = data[offset:offset + THROTTLE_CHUNK_SIZE]
+            self.wfile.write(chunk)
+            time.sleep(len(chunk) / (args.bandwidth_mbps * 1024 * 1024))
+
+    do_GET = forward
+    do_HEAD = forward
+    do_PUT = forward
+    do_POST = forward
+    do_DELETE = forward
+
+server = ThreadingHTTPServer(('127.0.0.1', args.port), ProxyHandler)
+print(f"Proxying 127.0.0.1:{args.port} to {args.upstream} with {args.latency_ms}ms latency", flush=True)
+server.serve_forever()
@@ -0,0 +1,99 @@
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+import urllib.request
+
+### Parse script parameters
+parser = argparse.ArgumentParser(description='Run the metadata phases against delta tables served through the latency injecting proxy')
+parser.add_argument('--duckdb', help='Path to the duckdb binary (with the delta extension linked in)', required=False, default='./build/release/duckdb')
+parser.add_argument('-t', '--tables', help='Comma separated list of tables uploaded with scripts/upload_benchmark_data_to_minio.sh', required=False, default='files_1k,commits_1k,partitions_100,dvs_10pct')
+parser.add_argument('--phases', help='Comma separated list of phases to run', required=False, default='snapshot_load,listing,first_row,scan')
+parser.add_argument('-r', '--runs', help='Number of runs per phase', required=False, type=int, default=3)
+parser.add_argument('-p', '--port', help='Port for the proxy', required=False, type=int, default=9010)
+parser.add_argument('-u', '--upstream', help='Upstream object store endpoint', required=False, default='http://duckdb-minio.com:9000')
+parser.add_argument('-l', '--latency-ms', help='Latency added to every request', required=False, type=float, default=50)
+parser.add_argument('-j', '--jitter-ms', help='Jitter added on top of the latency', required=False, type=float, default=0)
+parser.add_argument('--tail-latency-ms', help='Latency added to the fraction of requests given by --tail-probability', required=False, type=float, default=0)
+parser.add_argument('--tail-probability', help='Fraction of the requests that get the tail latency', required=False, type=float, default=0)
+parser.add_argument('--hedge-budget', help='Value of the delta_scan_hedge_budget setting (0 disables hedging)', required=False, type=float, default=0)
+parser.add_argument('-b', '--bandwidth-mbps', help='Bandwidth limit per response in MB/s (0 is unlimited)', required=False, type=float, default=0)
+parser.add_argument('-o', '--output', help='CSV file to write the results to', required=False, default='benchmark_results/simulated_remote/simulated_remote.csv')
+args = parser.parse_args()
+
+CATEGORIES = ['head', 'list', 'log', 'dv', 'data', 'other']
+
+PHASES = {
+    'snapshot_load': "DESCRIBE SELECT * FROM delta_scan('{path}')",
+    'listing': "EXPLAIN SELECT * FROM delta_scan('{path}')",
+    'first_row': "SELECT * FROM delta_scan('{path}') LIMIT 1",
+    'scan': "SELECT count(*) FROM delta_scan('{path}')",
+}
+
+SECRET = f"""CREATE SECRET (
+    TYPE S3,
+    KEY_ID 'minio_duckdb_user',
+    SECRET 'minio_duckdb_user_password',
+    REGION 'eu-west-1',
+    ENDPOINT '127.0.0.1:{args.port}',
+    USE_SSL false,
+    URL_STYLE 'path'
+);"""
+
+proxy_url = f'http://127.0.0.1:{args.port}/__proxy'
+
+def proxy_request(endpoint, method='GET'):
+    request = urllib.request.Request(f'{proxy_url}/{endpoint}', method=method)
+    with urllib.request.urlopen(request) as response:
+        return json.loads(response.read())
+
+def start_proxy():
+    proxy = subprocess.Popen([sys.executable, os.path.join(os.path.dirname(__file__), 'latency_proxy.py'),
+                              '--port', str(args.port), '--upstream', args.upstream,
+                              '--latency-ms', str(args.latency_ms), '--jitter-ms', str(args.jitter_ms),
+                              '--tail-latency-ms', str(args.tail_latency_ms), '--tail-probability', str(args.tail_probability),
+                              '--bandwidth-mbps', str(args.bandwidth_mbps)])
+    for _ in range(100):
+        try:
+            proxy_request('stats')
+            return proxy
+        except Exception:
+            time.sleep(0.1)
+    proxy.kill()
+    raise Exception('Failed to start the latency proxy')
+
+def run_phase(query):
+    script = f".timer on\n{SECRET}\nSET delta_scan_hedge_budget = {args.hedge_budget};\n{query};\n"
+    result = subprocess.run([args.duckdb], input=script, capture_output=True, text=True)
+    if result.returncode != 0 or 'Error' in result.stderr:
+        raise Exception(f'Query failed: {query}\n{result.stderr}')
+    timings = re.findall(r'Run Time \(s\): real ([0-9.]+)', result.stdout)
+    return float(timings[-1])
+
+### Run the benchmark
+proxy = start_proxy()
+results = []
+try:
+    for table in args.tables.split(','):
+        path = f's3://test-bucket/metadata_scaling/{table}'
+        for phase in args.phases.split(','):
+            for run in range(args.runs):
+                proxy_request('reset', method='POST')
+                timing = run_phase(PHASES[phase].format(path=path))
+                request_stats = proxy_request('stats')
+                counts = {category: request_stats.get(category, {}).get('requests', 0) for category in CATEGORIES}
+                total_bytes = sum(entry['bytes'] for entry in request_stats.values())
+                results.append((table, phase, run, timing, counts, total_bytes))
+                print(f"{table:>20} {phase:>14} run {run}: {timing:8.3f}s, {sum(counts.values()):6} requests ({', '.join(f'{c}: {n}' for c, n in counts.items() if n > 0)})")
+finally:
+    proxy.kill()
+
+### Write results
+os.makedirs(os.path.dirname(args.output), exist_ok=True)
+with open(args.output, 'w') as f:
+    f.write(f"table,phase,run,timing,{','.join(CATEGORIES)},total_requests,bytes\n")
+    for table, phase, run, timing, counts, total_bytes in results:
+        f.write(f"{table},{phase},{run},{timing},{','.join(str(counts[c]) for c in CATEGORIES)},{sum(counts.values())},{total_bytes}\n")
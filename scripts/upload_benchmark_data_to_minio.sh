@@ -0,0 +1,7 @@
+#!/bin/bash
+# Uploads the tables of the metadata scaling benchmark (see benchmark/micro/metadata_scaling) to the local minio server,
+# generate them first by running the metadata scaling benchmarks or with the delta_generate table function.
+
+for table in "$@"; do
+  aws s3 cp --endpoint-url http://duckdb-minio.com:9000 --recursive "./data/generated/metadata_scaling/$table" "s3://test-bucket/metadata_scaling/$table"
+done
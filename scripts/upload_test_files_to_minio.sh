@@ -1,4 +1,9 @@
 #!/bin/bash
 
 aws s3 cp --endpoint-url http://duckdb-minio.com:9000 --recursive ./build/release/rust/src/delta_kernel/acceptance/tests/dat/out/reader_tests/generated "s3://test-bucket/dat"
-aws s3 cp --endpoint-url http://duckdb-minio.com:9000 --recursive ./build/release/rust/src/delta_kernel/acceptance/tests/dat/out/reader_tests/generated "s3://test-bucket-public/dat"
\ No newline at end of file
+aws s3 cp --endpoint-url http://duckdb-minio.com:9000 --recursive ./build/release/rust/src/delta_kernel/acceptance/tests/dat/out/reader_tests/generated "s3://test-bucket-public/dat"
+
+# Tables with many files, generated with the extension itself
+rm -rf ./build/release/generated_minio && mkdir -p ./build/release/generated_minio
+./build/release/duckdb -c "CALL delta_generate('./build/release/generated_minio/read_ahead', files := 100, rows_per_file := 10)"
+aws s3 cp --endpoint-url http://duckdb-minio.com:9000 --recursive ./build/release/generated_minio "s3://test-bucket/generated"
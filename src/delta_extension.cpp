@@ -6,6 +6,11 @@
 #include "delta_functions.hpp"
 #include "delta_log_types.hpp"
 #include "delta_macros.hpp"
+#include "functions/delta_distinct_counts.hpp"
+#include "functions/delta_query_cache.hpp"
+#include "functions/delta_scan/delta_read_ahead.hpp"
+#include "storage/delta_log_watcher.hpp"
+#include "storage/delta_materialized_table.hpp"
 #include "storage/delta_catalog.hpp"
 #include "storage/delta_transaction_manager.hpp"
 
@@ -24,6 +29,7 @@ static unique_ptr<Catalog> DeltaCatalogAttach(StorageExtensionInfo *storage_info
 
 	auto res = make_uniq<DeltaCatalog>(db, info.path, access_mode);
 
+	bool watch_log = false;
 	for (const auto &option : info.options) {
 		if (StringUtil::Lower(option.first) == "pin_snapshot") {
 			res->use_cache = option.second.GetValue<bool>();
@@ -35,6 +41,22 @@ static unique_ptr<Catalog> DeltaCatalogAttach(StorageExtensionInfo *storage_info
 			auto str = option.second.GetValue<string>();
 			res->filter_pushdown_mode = DeltaEnumUtils::FromString(str);
 		}
+		if (StringUtil::Lower(option.first) == "materialize" && option.second.GetValue<bool>()) {
+			res->materialized_table = make_uniq<DeltaMaterializedTable>(name);
+		}
+		if (StringUtil::Lower(option.first) == "watch_log") {
+			watch_log = option.second.GetValue<bool>();
+		}
+	}
+
+	if (watch_log) {
+		// A pinned snapshot never changes, while a watched one follows the log: the two can not be combined
+		if (res->use_cache) {
+			throw BinderException("The ATTACH options PIN_SNAPSHOT and WATCH_LOG can not be combined");
+		}
+		if (DeltaLogWatcher::IsSupported()) {
+			res->log_watcher = make_uniq<DeltaLogWatcher>(info.path);
+		}
 	}
 
 	res->SetDefaultTable(DEFAULT_SCHEMA, name);
@@ -67,6 +89,15 @@ static void LoadInternal(DatabaseInstance &instance) {
 		ExtensionUtil::RegisterFunction(instance, function);
 	}
 
+	// Load the cache functions, delta_clear_cache clears all caches or those of a single table
+	TableFunctionSet clear_cache_set("delta_clear_cache");
+	DeltaClearCacheFunction clear_cache_function;
+	clear_cache_set.AddFunction(clear_cache_function);
+	clear_cache_function.arguments = {LogicalType::VARCHAR};
+	clear_cache_set.AddFunction(clear_cache_function);
+	ExtensionUtil::RegisterFunction(instance, clear_cache_set);
+	ExtensionUtil::RegisterFunction(instance, DeltaCacheInfoFunction());
+
 	// Register the "single table" delta catalog (to ATTACH a single delta table)
 	auto &config = DBConfig::GetConfig(instance);
 	config.storage_extensions["delta"] = make_uniq<DeltaStorageExtension>();
@@ -75,6 +106,10 @@ static void LoadInternal(DatabaseInstance &instance) {
 	                          "Adds the filtered files to the explain output. Warning: this may impact performance of "
 	                          "delta scan during explain analyze queries.",
 	                          LogicalType::BOOLEAN, Value(true));
+	config.AddExtensionOption(ADAPTIVE_PUSHDOWN_THRESHOLD_SETTING,
+	                          "Minimum fraction of files filters are expected to prune for the adaptive filter pushdown "
+	                          "mode to push them down.",
+	                          LogicalType::DOUBLE, Value::DOUBLE(0.2));
 
 	config.AddExtensionOption(
 	    "delta_kernel_logging",
@@ -82,6 +117,27 @@ static void LoadInternal(DatabaseInstance &instance) {
 	    "performance even with DuckDB logging disabled.",
 	    LogicalType::BOOLEAN, Value(false), LoggerCallback::DuckDBSettingCallBack);
 
+	config.AddExtensionOption(DeltaReadAhead::SETTING_NAME,
+	                          "Maximum number of upcoming files of a delta scan on remote storage of which the parquet "
+	                          "footer is prefetched (0 disables read-ahead).",
+	                          LogicalType::UBIGINT, Value::UBIGINT(8));
+	config.AddExtensionOption(DeltaReadAhead::HEDGE_BUDGET_SETTING_NAME,
+	                          "Maximum fraction of additional requests issued to hedge slow footer prefetches of a delta "
+	                          "scan (0 disables hedging).",
+	                          LogicalType::DOUBLE, Value::DOUBLE(0), DeltaReadAhead::ValidateHedgeSetting);
+	config.AddExtensionOption(DeltaReadAhead::HEDGE_PERCENTILE_SETTING_NAME,
+	                          "Latency percentile of recent footer prefetches after which a prefetch is hedged.",
+	                          LogicalType::DOUBLE, Value::DOUBLE(0.95), DeltaReadAhead::ValidateHedgeSetting);
+
+	config.AddExtensionOption(DeltaQueryCache::SETTING_NAME,
+	                          "Maximum memory used by the results cached by delta_cached_query. Lowering it evicts the "
+	                          "least recently used results.",
+	                          LogicalType::VARCHAR, Value("256MB"), DeltaQueryCache::ResizeOnSetting);
+
+	config.AddExtensionOption(DeltaDistinctCounts::DIRECTORY_SETTING_NAME,
+	                          "Directory holding the distinct count sketches of the files analyzed by delta_analyze.",
+	                          LogicalType::VARCHAR, Value("~/.duckdb/delta_analyze"));
+
 	DeltaMacros::RegisterMacros(instance);
 
 	DeltaLogTypes::RegisterLogTypes(instance);
@@ -9,6 +9,11 @@ vector<TableFunctionSet> DeltaFunctions::GetTableFunctions(DatabaseInstance &ins
 	vector<TableFunctionSet> functions;
 
 	functions.push_back(GetDeltaScanFunction(instance));
+	functions.push_back(GetDeltaGenerateFunction(instance));
+	functions.push_back(GetDeltaCachedQueryFunction(instance));
+	functions.push_back(GetDeltaCreateAggregateViewFunction(instance));
+	functions.push_back(GetDeltaRefreshAggregateViewFunction(instance));
+	functions.push_back(GetDeltaAnalyzeFunction(instance));
 
 	return functions;
 }
@@ -19,6 +19,7 @@ SELECT
     parse_delta_filter_logline(l2.message)['files_after'] as files_after,
     parse_delta_filter_logline(l2.message)['filters_before'] as filters_before,
     parse_delta_filter_logline(l2.message)['filters_after'] as filters_after,
+    parse_delta_filter_logline(l2.message)['decision'] as decision,
     parse_delta_filter_logline(l2.message)['path'] as path
 FROM duckdb_logs as l1
 JOIN duckdb_logs as l2 ON
@@ -37,6 +38,7 @@ SELECT
     files_after,
     filters_before,
     filters_after,
+    decision,
     path
 FROM
     delta_filter_pushdown_log()
@@ -76,7 +78,7 @@ static DefaultMacro delta_macros[] = {
      {"x", nullptr},
      {{nullptr, nullptr}},
      "x::STRUCT(path VARCHAR, type VARCHAR, filters_before VARCHAR[], filters_after VARCHAR[], files_before BIGINT, "
-     "files_after BIGINT)"},
+     "files_after BIGINT, decision VARCHAR)"},
 };
 
 void DeltaMacros::RegisterMacros(DatabaseInstance &instance) {
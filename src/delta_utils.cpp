@@ -7,6 +7,7 @@
 #include "duckdb/common/types/decimal.hpp"
 #include "duckdb/main/extension_util.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
 #include "duckdb/common/exception/conversion_exception.hpp"
 #include "duckdb/parser/expression/conjunction_expression.hpp"
@@ -470,9 +471,11 @@ unique_ptr<SchemaVisitor::FieldList> SchemaVisitor::VisitSnapshotSchema(ffi::Sha
 	return state.TakeFieldList(result);
 }
 
-unique_ptr<SchemaVisitor::FieldList> SchemaVisitor::VisitSnapshotGlobalReadSchema(ffi::SharedScan *scan,
-                                                                                  bool logical) {
+unique_ptr<SchemaVisitor::FieldList>
+SchemaVisitor::VisitSnapshotGlobalReadSchema(ffi::SharedScan *scan, bool logical,
+                                             optional_ptr<SchemaVisitor::FieldIdList> field_ids) {
 	SchemaVisitor visitor_state;
+	visitor_state.capture_field_ids = field_ids != nullptr;
 	auto visitor = CreateSchemaVisitor(visitor_state);
 
 	ffi::Handle<ffi::SharedSchema> schema;
@@ -489,12 +492,15 @@ unique_ptr<SchemaVisitor::FieldList> SchemaVisitor::VisitSnapshotGlobalReadSchem
 		visitor_state.error.Throw();
 	}
 
+	if (field_ids) {
+		*field_ids = visitor_state.TakeFieldIds(result);
+	}
 	return visitor_state.TakeFieldList(result);
 }
 
 void SchemaVisitor::VisitDecimal(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
                                  bool is_nullable, const ffi::CStringMap *metadata, uint8_t precision, uint8_t scale) {
-	state->AppendToList(sibling_list_id, name, LogicalType::DECIMAL(precision, scale));
+	state->AppendToList(sibling_list_id, name, LogicalType::DECIMAL(precision, scale), metadata);
 }
 
 uintptr_t SchemaVisitor::MakeFieldList(SchemaVisitor *state, uintptr_t capacity_hint) {
@@ -504,23 +510,38 @@ uintptr_t SchemaVisitor::MakeFieldList(SchemaVisitor *state, uintptr_t capacity_
 void SchemaVisitor::VisitStruct(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
                                 bool is_nullable, const ffi::CStringMap *metadata, uintptr_t child_list_id) {
 	auto children = state->TakeFieldList(child_list_id);
-	state->AppendToList(sibling_list_id, name, LogicalType::STRUCT(std::move(*children)));
+	auto child_field_ids = state->TakeFieldIds(child_list_id);
+	state->AppendToList(sibling_list_id, name, LogicalType::STRUCT(std::move(*children)), metadata,
+	                    std::move(child_field_ids));
+}
+
+//! The field ids of the element of a list or the key and value of a map, the fields nested in them keep their ids
+SchemaVisitor::FieldIdList SchemaVisitor::TakeCollectionFieldIds(SchemaVisitor &state, uintptr_t child_list_id) {
+	auto field_ids = state.TakeFieldIds(child_list_id);
+	for (auto &field_id : field_ids) {
+		field_id.collection_element = true;
+	}
+	return field_ids;
 }
 
 void SchemaVisitor::VisitArray(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
                                bool is_nullable, const ffi::CStringMap *metadata, uintptr_t child_list_id) {
 	auto children = state->TakeFieldList(child_list_id);
+	auto child_field_ids = TakeCollectionFieldIds(*state, child_list_id);
 
 	D_ASSERT(children->size() == 1);
-	state->AppendToList(sibling_list_id, name, LogicalType::LIST(children->front().second));
+	state->AppendToList(sibling_list_id, name, LogicalType::LIST(children->front().second), metadata,
+	                    std::move(child_field_ids));
 }
 
 void SchemaVisitor::VisitMap(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
                              bool is_nullable, const ffi::CStringMap *metadata, uintptr_t child_list_id) {
 	auto children = state->TakeFieldList(child_list_id);
+	auto child_field_ids = TakeCollectionFieldIds(*state, child_list_id);
 
 	D_ASSERT(children->size() == 2);
-	state->AppendToList(sibling_list_id, name, LogicalType::MAP(LogicalType::STRUCT(std::move(*children))));
+	state->AppendToList(sibling_list_id, name, LogicalType::MAP(LogicalType::STRUCT(std::move(*children))), metadata,
+	                    std::move(child_field_ids));
 }
 
 uintptr_t SchemaVisitor::MakeFieldListImpl(uintptr_t capacity_hint) {
@@ -530,16 +551,48 @@ uintptr_t SchemaVisitor::MakeFieldListImpl(uintptr_t capacity_hint) {
 		list->reserve(capacity_hint);
 	}
 	inflight_lists.emplace(id, std::move(list));
+	if (capture_field_ids) {
+		inflight_field_ids.emplace(id, FieldIdList());
+	}
 	return id;
 }
 
-void SchemaVisitor::AppendToList(uintptr_t id, ffi::KernelStringSlice name, LogicalType &&child) {
+static Value GetParquetFieldId(const ffi::CStringMap *metadata) {
+	if (!metadata) {
+		return Value();
+	}
+	auto ptr = ffi::get_from_string_map(metadata, KernelUtils::ToDeltaString("parquet.field.id"),
+	                                    [](ffi::KernelStringSlice kernel_str) -> ffi::NullableCvoid {
+		                                    return new string(KernelUtils::FromDeltaString(kernel_str));
+	                                    });
+	if (!ptr) {
+		return Value();
+	}
+	auto field_id_string = static_cast<string *>(ptr);
+	auto field_id = Value(*field_id_string);
+	delete field_id_string;
+
+	Value result;
+	string error_message;
+	if (!field_id.DefaultTryCastAs(LogicalType::INTEGER, result, &error_message)) {
+		return Value();
+	}
+	return result;
+}
+
+void SchemaVisitor::AppendToList(uintptr_t id, ffi::KernelStringSlice name, LogicalType &&child,
+                                 const ffi::CStringMap *metadata, FieldIdList child_field_ids) {
 	auto it = inflight_lists.find(id);
 	if (it == inflight_lists.end()) {
 		error = ErrorData(ExceptionType::INTERNAL, "Unhandled error in SchemaVisitor::AppendToList");
 		return;
 	}
 	it->second->emplace_back(std::make_pair(string(name.ptr, name.len), std::move(child)));
+
+	if (capture_field_ids) {
+		auto &field_ids = inflight_field_ids[id];
+		field_ids.push_back(DeltaFieldId {GetParquetFieldId(metadata), std::move(child_field_ids)});
+	}
 }
 
 unique_ptr<SchemaVisitor::FieldList> SchemaVisitor::TakeFieldList(uintptr_t id) {
@@ -553,6 +606,20 @@ unique_ptr<SchemaVisitor::FieldList> SchemaVisitor::TakeFieldList(uintptr_t id)
 	return rval;
 }
 
+SchemaVisitor::FieldIdList SchemaVisitor::TakeFieldIds(uintptr_t id) {
+	if (!capture_field_ids) {
+		return FieldIdList();
+	}
+	auto it = inflight_field_ids.find(id);
+	if (it == inflight_field_ids.end()) {
+		error = ErrorData(ExceptionType::INTERNAL, "Unhandled error in SchemaVisitor::TakeFieldIds");
+		return FieldIdList();
+	}
+	auto rval = std::move(it->second);
+	inflight_field_ids.erase(it);
+	return rval;
+}
+
 ffi::EngineError *DuckDBEngineError::AllocateError(ffi::KernelError etype, ffi::KernelStringSlice msg) {
 	auto error = new DuckDBEngineError;
 	error->etype = etype;
@@ -884,4 +951,26 @@ void LoggerCallback::DuckDBSettingCallBack(ClientContext &context, SetScope scop
 	}
 }
 
+DeltaMemoryReservation::DeltaMemoryReservation(BufferManager &buffer_manager_p) : buffer_manager(buffer_manager_p) {
+}
+
+DeltaMemoryReservation::~DeltaMemoryReservation() {
+	if (reserved > 0) {
+		buffer_manager.FreeReservedMemory(reserved);
+	}
+}
+
+void DeltaMemoryReservation::Resize(idx_t new_size) {
+	if (new_size > reserved) {
+		auto increment = AlignValue<idx_t, RESERVATION_GRANULARITY>(new_size - reserved);
+		buffer_manager.ReserveMemory(increment);
+		reserved += increment;
+	} else if (reserved - new_size > 2 * RESERVATION_GRANULARITY) {
+		auto new_reserved = AlignValue<idx_t, RESERVATION_GRANULARITY>(new_size);
+		buffer_manager.FreeReservedMemory(reserved - new_reserved);
+		reserved = new_reserved;
+	}
+	size = new_size;
+}
+
 }; // namespace duckdb
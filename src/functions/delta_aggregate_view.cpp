@@ -0,0 +1,353 @@
+#include "delta_functions.hpp"
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+#include "functions/delta_scan/delta_scan.hpp"
+
+#include "duckdb/catalog/catalog_search_path.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/parser.hpp"
+
+namespace duckdb {
+
+//! Aggregate views keep per-file partial aggregates of a Delta table in DuckDB tables, the view combines them. A
+//! refresh only computes the partial aggregates of the files added since the last refresh, and drops those of the
+//! removed files (a file whose deletion vector changed is both removed and added)
+static constexpr const char *AGGREGATE_VIEWS_TABLE = "__delta_aggregate_views";
+
+struct DeltaAggregateViewBindData : public TableFunctionData {
+	string name;
+	//! The catalog and schema the view and its tables live in: the current ones of the caller
+	string catalog;
+	string schema;
+	//! Only set when creating the view
+	string path;
+	vector<string> group_by;
+	vector<string> aggregates;
+};
+
+struct DeltaAggregateViewGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+//! The column of the partials table holding the file the partial aggregates were computed over
+static constexpr const char *FILE_COLUMN = "__delta_file";
+
+static string QualifyName(const DeltaAggregateViewBindData &data, const string &name) {
+	return KeywordHelper::WriteOptionallyQuoted(data.catalog) + "." +
+	       KeywordHelper::WriteOptionallyQuoted(data.schema) + "." + KeywordHelper::WriteOptionallyQuoted(name);
+}
+
+static string GetViewsTableName(const DeltaAggregateViewBindData &data) {
+	return QualifyName(data, AGGREGATE_VIEWS_TABLE);
+}
+
+static string GetPartialsTableName(const DeltaAggregateViewBindData &data) {
+	return QualifyName(data, "__delta_aggregate_view_" + data.name + "_partials");
+}
+
+static string GetFilesTableName(const DeltaAggregateViewBindData &data) {
+	return QualifyName(data, "__delta_aggregate_view_" + data.name + "_files");
+}
+
+static void RunQuery(Connection &con, const string &query) {
+	auto result = con.Query(query);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+}
+
+static unique_ptr<ParsedExpression> ParseViewExpression(const string &expression, string &name) {
+	auto expressions = Parser::ParseExpressionList(expression);
+	if (expressions.size() != 1) {
+		throw InvalidInputException("Aggregate view expressions must be single expressions, got '%s'", expression);
+	}
+	auto result = std::move(expressions[0]);
+	name = result->alias;
+	if (name.empty()) {
+		name = expression;
+		StringUtil::Trim(name);
+	}
+	result->alias.clear();
+	return result;
+}
+
+//! Build the select list computing the partial aggregates per file, and the select list combining them
+static void BuildAggregateViewQueries(const vector<string> &group_by, const vector<string> &aggregates,
+                                      string &partial_select, string &final_select) {
+	vector<string> partial_list;
+	vector<string> final_list;
+	for (idx_t i = 0; i < group_by.size(); i++) {
+		string name;
+		auto expression = ParseViewExpression(group_by[i], name);
+		partial_list.push_back(StringUtil::Format("%s AS g%llu", expression->ToString(), i));
+		final_list.push_back(StringUtil::Format("g%llu AS %s", i, KeywordHelper::WriteOptionallyQuoted(name)));
+	}
+	for (idx_t i = 0; i < aggregates.size(); i++) {
+		string name;
+		auto expression = ParseViewExpression(aggregates[i], name);
+		if (expression->GetExpressionClass() != ExpressionClass::FUNCTION) {
+			throw InvalidInputException("Aggregate view aggregates must be aggregate functions, got '%s'",
+			                            aggregates[i]);
+		}
+		auto &function = expression->Cast<FunctionExpression>();
+		auto function_name = StringUtil::Lower(function.function_name);
+		if (function.distinct || function.filter || (function.order_bys && !function.order_bys->orders.empty())) {
+			throw InvalidInputException("Aggregate view aggregates do not support DISTINCT, FILTER or ORDER BY");
+		}
+		auto quoted_name = KeywordHelper::WriteOptionallyQuoted(name);
+		if (function_name == "count_star") {
+			partial_list.push_back(StringUtil::Format("count(*) AS a%llu", i));
+			final_list.push_back(StringUtil::Format("coalesce(sum(a%llu), 0)::BIGINT AS %s", i, quoted_name));
+			continue;
+		}
+		if (function.children.size() != 1) {
+			throw InvalidInputException("Aggregate view aggregates must have a single argument, got '%s'",
+			                            aggregates[i]);
+		}
+		auto argument = function.children[0]->ToString();
+		if (function_name == "count") {
+			partial_list.push_back(StringUtil::Format("count(%s) AS a%llu", argument, i));
+			final_list.push_back(StringUtil::Format("coalesce(sum(a%llu), 0)::BIGINT AS %s", i, quoted_name));
+		} else if (function_name == "sum" || function_name == "min" || function_name == "max") {
+			partial_list.push_back(StringUtil::Format("%s(%s) AS a%llu", function_name, argument, i));
+			final_list.push_back(StringUtil::Format("%s(a%llu) AS %s", function_name, i, quoted_name));
+		} else if (function_name == "avg") {
+			partial_list.push_back(StringUtil::Format("sum(%s) AS a%llu_sum, count(%s) AS a%llu_count", argument, i,
+			                                          argument, i));
+			final_list.push_back(
+			    StringUtil::Format("sum(a%llu_sum)::DOUBLE / sum(a%llu_count) AS %s", i, i, quoted_name));
+		} else {
+			throw InvalidInputException("Aggregate views support count, sum, min, max and avg, got '%s'",
+			                            aggregates[i]);
+		}
+	}
+	if (aggregates.empty()) {
+		throw InvalidInputException("Aggregate views need at least one aggregate");
+	}
+	partial_select = StringUtil::Join(partial_list, ", ");
+	final_select = StringUtil::Join(final_list, ", ");
+}
+
+static string GetFileList(const unordered_set<string> &files) {
+	vector<string> values;
+	for (auto &file : files) {
+		values.push_back(Value(file).ToSQLString());
+	}
+	return StringUtil::Join(values, ", ");
+}
+
+//! Bring the partial aggregates of the view up to date with the latest version of the table
+static void RefreshAggregateView(Connection &con, const DeltaAggregateViewBindData &data, DataChunk &output) {
+	auto &name = data.name;
+	con.BeginTransaction();
+	try {
+		auto view_result = con.Query(StringUtil::Format("SELECT path, version, partial_select FROM %s WHERE name = %s",
+		                                                GetViewsTableName(data), Value(name).ToSQLString()));
+		if (view_result->HasError()) {
+			view_result->ThrowError();
+		}
+		if (view_result->RowCount() == 0) {
+			throw InvalidInputException("Aggregate view '%s' does not exist", name);
+		}
+		auto path = view_result->GetValue(0, 0).ToString();
+		auto view_version = view_result->GetValue(1, 0).GetValue<int64_t>();
+		auto partial_select = view_result->GetValue(2, 0).ToString();
+
+		auto snapshot = make_shared_ptr<DeltaMultiFileList>(*con.context, path);
+		auto version = NumericCast<int64_t>(snapshot->GetVersion());
+		unordered_set<string> removed_files;
+		unordered_set<string> added_files;
+		if (version != view_version) {
+			auto new_files = snapshot->GetFileSignatures();
+			auto files_result =
+			    con.Query(StringUtil::Format("SELECT path, signature FROM %s", GetFilesTableName(data)));
+			if (files_result->HasError()) {
+				files_result->ThrowError();
+			}
+			unordered_map<string, hash_t> old_files;
+			for (idx_t i = 0; i < files_result->RowCount(); i++) {
+				old_files[files_result->GetValue(0, i).ToString()] = files_result->GetValue(1, i).GetValue<hash_t>();
+			}
+			for (auto &file : old_files) {
+				auto entry = new_files.find(file.first);
+				if (entry == new_files.end() || entry->second != file.second) {
+					removed_files.insert(file.first);
+				}
+			}
+			vector<string> added_rows;
+			for (auto &file : new_files) {
+				auto entry = old_files.find(file.first);
+				if (entry == old_files.end() || entry->second != file.second) {
+					added_files.insert(file.first);
+					added_rows.push_back(
+					    StringUtil::Format("(%s, %llu)", Value(file.first).ToSQLString(), file.second));
+				}
+			}
+
+			if (!removed_files.empty()) {
+				auto file_list = GetFileList(removed_files);
+				RunQuery(con, StringUtil::Format("DELETE FROM %s WHERE %s IN (%s)", GetPartialsTableName(data),
+				                                 FILE_COLUMN, file_list));
+				RunQuery(con, StringUtil::Format("DELETE FROM %s WHERE path IN (%s)", GetFilesTableName(data),
+				                                 file_list));
+			}
+			if (!added_files.empty()) {
+				auto insert_query = StringUtil::Format(
+				    "INSERT INTO %s SELECT %s, %s FROM delta_scan({path}, filename := %s) GROUP BY ALL",
+				    GetPartialsTableName(data), FILE_COLUMN, partial_select, Value(FILE_COLUMN).ToSQLString());
+				RunQuery(con, StringUtil::Format("INSERT INTO %s VALUES %s", GetFilesTableName(data),
+				                                 StringUtil::Join(added_rows, ", ")));
+				DeltaSnapshotRegistry::QueryFiles(con, *snapshot, added_files, insert_query);
+			}
+			RunQuery(con, StringUtil::Format("UPDATE %s SET version = %lld WHERE name = %s", GetViewsTableName(data),
+			                                 version, Value(name).ToSQLString()));
+		}
+		con.Commit();
+
+		output.SetValue(0, 0, Value::BIGINT(version));
+		output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(added_files.size())));
+		output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(removed_files.size())));
+		output.SetCardinality(1);
+	} catch (...) {
+		con.Rollback();
+		throw;
+	}
+}
+
+static void CreateAggregateView(Connection &con, const DeltaAggregateViewBindData &data) {
+	string partial_select;
+	string final_select;
+	BuildAggregateViewQueries(data.group_by, data.aggregates, partial_select, final_select);
+
+	con.BeginTransaction();
+	try {
+		RunQuery(con, StringUtil::Format("CREATE TABLE IF NOT EXISTS %s (name VARCHAR PRIMARY KEY, path VARCHAR, "
+		                                 "version BIGINT, partial_select VARCHAR)",
+		                                 GetViewsTableName(data)));
+		RunQuery(con, StringUtil::Format("INSERT INTO %s VALUES (%s, %s, -1, %s)", GetViewsTableName(data),
+		                                 Value(data.name).ToSQLString(), Value(data.path).ToSQLString(),
+		                                 Value(partial_select).ToSQLString()));
+
+		// The partials table is created from an empty scan, so its columns have the types of the partial aggregates
+		auto snapshot = make_shared_ptr<DeltaMultiFileList>(*con.context, data.path);
+		auto create_query = StringUtil::Format(
+		    "CREATE TABLE %s AS SELECT %s, %s FROM delta_scan({path}, filename := %s) GROUP BY ALL",
+		    GetPartialsTableName(data), FILE_COLUMN, partial_select, Value(FILE_COLUMN).ToSQLString());
+		DeltaSnapshotRegistry::QueryFiles(con, *snapshot, unordered_set<string>(), create_query);
+		// The signature identifies the deletion vector of the file, see DeltaMultiFileList::GetFileSignatures
+		RunQuery(con, StringUtil::Format("CREATE TABLE %s (path VARCHAR, signature UBIGINT)", GetFilesTableName(data)));
+		RunQuery(con, StringUtil::Format("CREATE VIEW %s AS SELECT %s FROM %s GROUP BY ALL",
+		                                 QualifyName(data, data.name), final_select, GetPartialsTableName(data)));
+		con.Commit();
+	} catch (...) {
+		con.Rollback();
+		throw;
+	}
+}
+
+//! The view is created in (and looked up from) the current catalog and schema of the caller, not those of the
+//! connection maintaining it
+static void BindAggregateViewResult(ClientContext &context, DeltaAggregateViewBindData &data,
+                                    vector<LogicalType> &return_types, vector<string> &names) {
+	auto default_entry = ClientData::Get(context).catalog_search_path->GetDefault();
+	data.catalog = default_entry.catalog;
+	if (IsInvalidCatalog(data.catalog)) {
+		data.catalog = DatabaseManager::GetDefaultDatabase(context);
+	}
+	data.schema = default_entry.schema;
+	if (IsInvalidSchema(data.schema)) {
+		data.schema = DEFAULT_SCHEMA;
+	}
+
+	names.emplace_back("version");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("files_added");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("files_removed");
+	return_types.emplace_back(LogicalType::BIGINT);
+}
+
+static unique_ptr<FunctionData> DeltaCreateAggregateViewBind(ClientContext &context, TableFunctionBindInput &input,
+                                                             vector<LogicalType> &return_types,
+                                                             vector<string> &names) {
+	auto result = make_uniq<DeltaAggregateViewBindData>();
+	result->name = input.inputs[0].GetValue<string>();
+	result->path = input.inputs[1].GetValue<string>();
+	for (auto &group : ListValue::GetChildren(input.inputs[2])) {
+		result->group_by.push_back(group.GetValue<string>());
+	}
+	for (auto &aggregate : ListValue::GetChildren(input.inputs[3])) {
+		result->aggregates.push_back(aggregate.GetValue<string>());
+	}
+	BindAggregateViewResult(context, *result, return_types, names);
+	return std::move(result);
+}
+
+static unique_ptr<FunctionData> DeltaRefreshAggregateViewBind(ClientContext &context, TableFunctionBindInput &input,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	auto result = make_uniq<DeltaAggregateViewBindData>();
+	result->name = input.inputs[0].GetValue<string>();
+	BindAggregateViewResult(context, *result, return_types, names);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> DeltaAggregateViewInit(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	return make_uniq<DeltaAggregateViewGlobalState>();
+}
+
+static void DeltaCreateAggregateViewFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DeltaAggregateViewBindData>();
+	auto &state = data_p.global_state->Cast<DeltaAggregateViewGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+
+	// The view is maintained through a separate connection, so we don't interfere with the query that is currently
+	// running in this context
+	Connection con(*context.db);
+	CreateAggregateView(con, data);
+	RefreshAggregateView(con, data, output);
+}
+
+static void DeltaRefreshAggregateViewFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DeltaAggregateViewBindData>();
+	auto &state = data_p.global_state->Cast<DeltaAggregateViewGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+
+	Connection con(*context.db);
+	RefreshAggregateView(con, data, output);
+}
+
+TableFunctionSet DeltaFunctions::GetDeltaCreateAggregateViewFunction(DatabaseInstance &instance) {
+	TableFunctionSet result("delta_create_aggregate_view");
+
+	auto string_list = LogicalType::LIST(LogicalType::VARCHAR);
+	TableFunction function({LogicalType::VARCHAR, LogicalType::VARCHAR, string_list, string_list},
+	                       DeltaCreateAggregateViewFunction, DeltaCreateAggregateViewBind, DeltaAggregateViewInit);
+	result.AddFunction(function);
+
+	return result;
+}
+
+TableFunctionSet DeltaFunctions::GetDeltaRefreshAggregateViewFunction(DatabaseInstance &instance) {
+	TableFunctionSet result("delta_refresh_aggregate_view");
+
+	TableFunction function({LogicalType::VARCHAR}, DeltaRefreshAggregateViewFunction, DeltaRefreshAggregateViewBind,
+	                       DeltaAggregateViewInit);
+	result.AddFunction(function);
+
+	return result;
+}
+
+} // namespace duckdb
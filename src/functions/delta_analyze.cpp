@@ -0,0 +1,411 @@
+#include "delta_functions.hpp"
+#include "functions/delta_distinct_counts.hpp"
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+#include "functions/delta_scan/delta_scan.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+shared_ptr<DeltaDistinctCounts> DeltaDistinctCounts::Get(ClientContext &context) {
+	return ObjectCache::GetObjectCache(context).GetOrCreate<DeltaDistinctCounts>(ObjectType());
+}
+
+void DeltaDistinctCounts::Put(const string &path, idx_t version, const string &column, idx_t distinct_count) {
+	lock_guard<mutex> guard(lock);
+	auto &table = distinct_counts[path];
+	if (table.version != version) {
+		table.version = version;
+		table.columns.clear();
+		table.hits = 0;
+		table.created = Timestamp::GetCurrentTimestamp();
+	}
+	table.columns[column] = distinct_count;
+}
+
+optional_idx DeltaDistinctCounts::Lookup(const string &path, idx_t version, const string &column) {
+	lock_guard<mutex> guard(lock);
+	auto table = distinct_counts.find(path);
+	if (table == distinct_counts.end() || table->second.version != version) {
+		return optional_idx();
+	}
+	auto entry = table->second.columns.find(column);
+	if (entry == table->second.columns.end()) {
+		return optional_idx();
+	}
+	table->second.hits++;
+	return entry->second;
+}
+
+void DeltaDistinctCounts::Clear() {
+	lock_guard<mutex> guard(lock);
+	distinct_counts.clear();
+}
+
+bool DeltaDistinctCounts::ClearTable(const string &path) {
+	lock_guard<mutex> guard(lock);
+	return distinct_counts.erase(path) > 0;
+}
+
+bool DeltaDistinctCounts::HasVersion(const string &path, idx_t version) {
+	lock_guard<mutex> guard(lock);
+	auto table = distinct_counts.find(path);
+	return table != distinct_counts.end() && table->second.version == version;
+}
+
+void DeltaDistinctCounts::PutVersion(const string &path, idx_t version, case_insensitive_map_t<idx_t> columns) {
+	lock_guard<mutex> guard(lock);
+	auto &table = distinct_counts[path];
+	table.version = version;
+	table.columns = std::move(columns);
+	table.hits = 0;
+	table.created = Timestamp::GetCurrentTimestamp();
+}
+
+vector<DeltaDistinctCountsInfo> DeltaDistinctCounts::GetEntries() {
+	lock_guard<mutex> guard(lock);
+	vector<DeltaDistinctCountsInfo> result;
+	for (auto &table : distinct_counts) {
+		// Versions loaded without any sketches in the sidecar are only kept to not look for them again
+		if (table.second.columns.empty()) {
+			continue;
+		}
+		result.push_back(DeltaDistinctCountsInfo {table.first, table.second.version, table.second.hits,
+		                                          table.second.created});
+	}
+	return result;
+}
+
+//! The distinct values of a column are counted with a HyperLogLog sketch per file: the low bits of the hash of a value
+//! select a register, which keeps the maximum position of the first set bit in the remaining bits. The sketches of
+//! the files of a snapshot are merged by taking the maximum of every register. Sketches are stored sparsely (only the
+//! registers that are set) in a parquet sidecar per table, a row without register marks the file as analyzed
+static constexpr idx_t SKETCH_BITS = 10;
+static constexpr idx_t SKETCH_REGISTERS = 1 << SKETCH_BITS;
+static constexpr const char *SKETCH_TABLE = "__delta_analyze_sketches";
+static constexpr const char *FILES_TABLE = "__delta_analyze_files";
+
+struct DeltaAnalyzeBindData : public TableFunctionData {
+	shared_ptr<DeltaMultiFileList> snapshot;
+	vector<string> columns;
+};
+
+struct DeltaAnalyzeResult {
+	string column;
+	idx_t distinct_count;
+	idx_t files_analyzed;
+};
+
+struct DeltaAnalyzeGlobalState : public GlobalTableFunctionState {
+	bool analyzed = false;
+	vector<DeltaAnalyzeResult> results;
+	idx_t offset = 0;
+};
+
+static void RunQuery(Connection &con, const string &query) {
+	auto result = con.Query(query);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+}
+
+//! The directory holding the sidecars, empty if it is not set
+static string GetSidecarDirectory(ClientContext &context) {
+	Value directory_value;
+	if (!context.TryGetCurrentSetting(DeltaDistinctCounts::DIRECTORY_SETTING_NAME, directory_value) ||
+	    directory_value.IsNull()) {
+		return string();
+	}
+	auto directory = directory_value.ToString();
+	return directory.empty() ? directory : FileSystem::GetFileSystem(context).ExpandPath(directory);
+}
+
+static string GetSidecarFile(FileSystem &fs, const string &directory, const string &table_path) {
+	return fs.JoinPath(directory, StringUtil::Format("%llu.parquet", Hash(table_path.c_str())));
+}
+
+static string GetSidecarPath(ClientContext &context, const string &table_path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto directory = GetSidecarDirectory(context);
+	if (directory.empty()) {
+		throw InvalidInputException("delta_analyze: '%s' must be set", DeltaDistinctCounts::DIRECTORY_SETTING_NAME);
+	}
+
+	// Create the directory and any missing parents
+	auto separator = fs.PathSeparator(directory);
+	for (idx_t position = directory.find(separator, 1); ; position = directory.find(separator, position + 1)) {
+		auto prefix = position == string::npos ? directory : directory.substr(0, position);
+		if (!prefix.empty() && !fs.DirectoryExists(prefix)) {
+			fs.CreateDirectory(prefix);
+		}
+		if (position == string::npos) {
+			break;
+		}
+	}
+	return GetSidecarFile(fs, directory, table_path);
+}
+
+//! Estimate the number of distinct values from the number of set registers and the sum of 2^-rank over them
+static idx_t EstimateDistinctCount(idx_t set_registers, double rank_sum) {
+	auto m = static_cast<double>(SKETCH_REGISTERS);
+	auto zero_registers = static_cast<double>(SKETCH_REGISTERS - set_registers);
+	auto alpha = 0.7213 / (1 + 1.079 / m);
+	auto estimate = alpha * m * m / (rank_sum + zero_registers);
+	// Linear counting is more accurate for small cardinalities
+	if (estimate <= 2.5 * m && zero_registers > 0) {
+		estimate = m * std::log(m / zero_registers);
+	}
+	return static_cast<idx_t>(std::round(estimate));
+}
+
+//! Merge the sketches of the files in source per column, and estimate the distinct counts from the merged sketches
+static case_insensitive_map_t<idx_t> MergeSketches(Connection &con, const string &source) {
+	auto merged = con.Query(StringUtil::Format(
+	    "SELECT column_name, count(*)::UBIGINT, sum(pow(2, -rank::INTEGER))::DOUBLE FROM (SELECT column_name, "
+	    "register, max(rank) AS rank FROM %s WHERE register IS NOT NULL GROUP BY ALL) GROUP BY ALL",
+	    source));
+	if (merged->HasError()) {
+		merged->ThrowError();
+	}
+	case_insensitive_map_t<idx_t> distinct_counts;
+	for (idx_t i = 0; i < merged->RowCount(); i++) {
+		distinct_counts[merged->GetValue(0, i).ToString()] =
+		    EstimateDistinctCount(merged->GetValue(1, i).GetValue<idx_t>(), merged->GetValue(2, i).GetValue<double>());
+	}
+	return distinct_counts;
+}
+
+//! Load the distinct counts of the snapshot from the sketches in the sidecar of the table. Only columns for which
+//! every file of the snapshot has a sketch are counted
+static case_insensitive_map_t<idx_t> LoadDistinctCounts(ClientContext &context, DeltaMultiFileList &snapshot) {
+	case_insensitive_map_t<idx_t> result;
+	auto directory = GetSidecarDirectory(context);
+	if (directory.empty()) {
+		return result;
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto sidecar_path = GetSidecarFile(fs, directory, snapshot.GetPath());
+	if (!fs.FileExists(sidecar_path)) {
+		return result;
+	}
+	auto file_signatures = snapshot.GetFileSignatures();
+	if (file_signatures.empty()) {
+		return result;
+	}
+
+	vector<string> file_rows;
+	for (auto &file : file_signatures) {
+		file_rows.push_back("(" + Value(file.first).ToSQLString() + ")");
+	}
+	auto source = StringUtil::Format("(SELECT * FROM read_parquet(%s) WHERE path IN (SELECT path FROM (VALUES %s) "
+	                                 "files(path)))",
+	                                 Value(sidecar_path).ToSQLString(), StringUtil::Join(file_rows, ", "));
+
+	// The sketches are read through a separate connection, the query of this context is being planned
+	Connection con(*context.db);
+	auto analyzed = con.Query(StringUtil::Format("SELECT column_name FROM %s WHERE register IS NULL GROUP BY ALL "
+	                                             "HAVING count(DISTINCT path) = %llu",
+	                                             source, file_signatures.size()));
+	if (analyzed->HasError()) {
+		analyzed->ThrowError();
+	}
+	if (analyzed->RowCount() == 0) {
+		return result;
+	}
+	auto distinct_counts = MergeSketches(con, source);
+	for (idx_t i = 0; i < analyzed->RowCount(); i++) {
+		auto column = analyzed->GetValue(0, i).ToString();
+		auto entry = distinct_counts.find(column);
+		// Columns without any non-NULL value have no registers set
+		result[column] = entry == distinct_counts.end() ? 0 : entry->second;
+	}
+	return result;
+}
+
+optional_idx DeltaDistinctCounts::GetDistinctCount(ClientContext &context, DeltaMultiFileList &snapshot,
+                                                   const string &column) {
+	auto cache = Get(context);
+	auto path = snapshot.GetPath();
+	auto version = snapshot.GetVersion();
+	// A filtered list only holds part of the files, the counts are loaded for the complete snapshot
+	if (!cache->HasVersion(path, version) && !snapshot.IsFiltered()) {
+		cache->PutVersion(path, version, LoadDistinctCounts(context, snapshot));
+	}
+	return cache->Lookup(path, version, column);
+}
+
+static vector<DeltaAnalyzeResult> AnalyzeTable(ClientContext &context, Connection &con, DeltaMultiFileList &snapshot,
+                                               const vector<string> &columns) {
+	auto sidecar_path = GetSidecarPath(context, snapshot.GetPath());
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	auto file_signatures = snapshot.GetFileSignatures();
+	RunQuery(con, StringUtil::Format("CREATE OR REPLACE TEMP TABLE %s (path VARCHAR, column_name VARCHAR, register "
+	                                 "USMALLINT, rank UTINYINT)",
+	                                 SKETCH_TABLE));
+	RunQuery(con, StringUtil::Format("CREATE OR REPLACE TEMP TABLE %s (path VARCHAR)", FILES_TABLE));
+	if (!file_signatures.empty()) {
+		vector<string> file_rows;
+		for (auto &file : file_signatures) {
+			file_rows.push_back("(" + Value(file.first).ToSQLString() + ")");
+		}
+		RunQuery(con, StringUtil::Format("INSERT INTO %s VALUES %s", FILES_TABLE, StringUtil::Join(file_rows, ", ")));
+	}
+
+	// Load the sketches of the files that are still part of the table
+	bool sidecar_changed = false;
+	if (fs.FileExists(sidecar_path)) {
+		RunQuery(con, StringUtil::Format("INSERT INTO %s SELECT * FROM read_parquet(%s)", SKETCH_TABLE,
+		                                 Value(sidecar_path).ToSQLString()));
+		auto removed = con.Query(StringUtil::Format("DELETE FROM %s WHERE path NOT IN (SELECT path FROM %s)",
+		                                            SKETCH_TABLE, FILES_TABLE));
+		if (removed->HasError()) {
+			removed->ThrowError();
+		}
+		sidecar_changed = removed->GetValue(0, 0).GetValue<int64_t>() > 0;
+	}
+
+	auto analyzed_result =
+	    con.Query(StringUtil::Format("SELECT column_name, path FROM %s WHERE register IS NULL", SKETCH_TABLE));
+	if (analyzed_result->HasError()) {
+		analyzed_result->ThrowError();
+	}
+	unordered_map<string, unordered_set<string>> analyzed_files;
+	for (idx_t i = 0; i < analyzed_result->RowCount(); i++) {
+		analyzed_files[analyzed_result->GetValue(0, i).ToString()].insert(analyzed_result->GetValue(1, i).ToString());
+	}
+
+	// Files are immutable, so only files without a sketch need to be read
+	vector<DeltaAnalyzeResult> results;
+	for (auto &column : columns) {
+		auto &column_files = analyzed_files[column];
+		unordered_set<string> new_files;
+		vector<string> marker_rows;
+		for (auto &file : file_signatures) {
+			if (column_files.find(file.first) == column_files.end()) {
+				new_files.insert(file.first);
+				marker_rows.push_back(StringUtil::Format("(%s, %s, NULL, NULL)", Value(file.first).ToSQLString(),
+				                                         Value(column).ToSQLString()));
+			}
+		}
+		if (!new_files.empty()) {
+			auto quoted_column = KeywordHelper::WriteOptionallyQuoted(column);
+			auto sketch_query = StringUtil::Format(
+			    "INSERT INTO %s SELECT filename, %s, (h & %llu)::USMALLINT, max(CASE WHEN h >> %llu = 0 THEN %llu ELSE "
+			    "%llu - floor(log2((h >> %llu)::DOUBLE))::INTEGER END)::UTINYINT FROM (SELECT filename, hash(%s) AS h "
+			    "FROM delta_scan({path}) WHERE %s IS NOT NULL) GROUP BY ALL",
+			    SKETCH_TABLE, Value(column).ToSQLString(), SKETCH_REGISTERS - 1, SKETCH_BITS, 65 - SKETCH_BITS,
+			    64 - SKETCH_BITS, SKETCH_BITS, quoted_column, quoted_column);
+			DeltaSnapshotRegistry::QueryFiles(con, snapshot, new_files, sketch_query);
+			RunQuery(con, StringUtil::Format("INSERT INTO %s VALUES %s", SKETCH_TABLE,
+			                                 StringUtil::Join(marker_rows, ", ")));
+			sidecar_changed = true;
+		}
+		results.push_back(DeltaAnalyzeResult {column, 0, new_files.size()});
+	}
+
+	if (sidecar_changed) {
+		RunQuery(con, StringUtil::Format("COPY %s TO %s (FORMAT parquet)", SKETCH_TABLE,
+		                                 Value(sidecar_path).ToSQLString()));
+	}
+
+	// Merge the sketches of all files of the snapshot
+	auto distinct_counts = MergeSketches(con, SKETCH_TABLE);
+	RunQuery(con, StringUtil::Format("DROP TABLE %s", SKETCH_TABLE));
+	RunQuery(con, StringUtil::Format("DROP TABLE %s", FILES_TABLE));
+
+	auto cache = DeltaDistinctCounts::Get(context);
+	auto version = snapshot.GetVersion();
+	for (auto &result : results) {
+		auto entry = distinct_counts.find(result.column);
+		result.distinct_count = entry == distinct_counts.end() ? 0 : entry->second;
+		cache->Put(snapshot.GetPath(), version, result.column, result.distinct_count);
+	}
+	return results;
+}
+
+static unique_ptr<FunctionData> DeltaAnalyzeBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<DeltaAnalyzeBindData>();
+	result->snapshot = make_shared_ptr<DeltaMultiFileList>(context, input.inputs[0].GetValue<string>());
+
+	vector<LogicalType> table_types;
+	vector<string> table_names;
+	result->snapshot->Bind(table_types, table_names);
+	case_insensitive_map_t<string> column_names;
+	for (auto &name : table_names) {
+		column_names[name] = name;
+	}
+
+	// Analyze all columns if none are specified
+	vector<string> requested_columns = table_names;
+	if (input.inputs.size() > 1) {
+		requested_columns.clear();
+		for (auto &column : ListValue::GetChildren(input.inputs[1])) {
+			requested_columns.push_back(column.GetValue<string>());
+		}
+	}
+	for (auto &column : requested_columns) {
+		auto entry = column_names.find(column);
+		if (entry == column_names.end()) {
+			throw BinderException("delta_analyze: column '%s' does not exist in the Delta table", column);
+		}
+		result->columns.push_back(entry->second);
+	}
+
+	names.emplace_back("column_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("distinct_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("files_analyzed");
+	return_types.emplace_back(LogicalType::BIGINT);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> DeltaAnalyzeInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<DeltaAnalyzeGlobalState>();
+}
+
+static void DeltaAnalyzeFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DeltaAnalyzeBindData>();
+	auto &state = data_p.global_state->Cast<DeltaAnalyzeGlobalState>();
+	if (!state.analyzed) {
+		// The sketches are computed through a separate connection, so we don't interfere with the query that is
+		// currently running in this context
+		Connection con(*context.db);
+		state.results = AnalyzeTable(context, con, *data.snapshot, data.columns);
+		state.analyzed = true;
+	}
+
+	idx_t count = 0;
+	while (state.offset < state.results.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &result = state.results[state.offset++];
+		output.SetValue(0, count, Value(result.column));
+		output.SetValue(1, count, Value::BIGINT(NumericCast<int64_t>(result.distinct_count)));
+		output.SetValue(2, count, Value::BIGINT(NumericCast<int64_t>(result.files_analyzed)));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+TableFunctionSet DeltaFunctions::GetDeltaAnalyzeFunction(DatabaseInstance &instance) {
+	TableFunctionSet result("delta_analyze");
+
+	TableFunction all_columns({LogicalType::VARCHAR}, DeltaAnalyzeFunction, DeltaAnalyzeBind, DeltaAnalyzeInit);
+	result.AddFunction(all_columns);
+	TableFunction function({LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR)}, DeltaAnalyzeFunction,
+	                       DeltaAnalyzeBind, DeltaAnalyzeInit);
+	result.AddFunction(function);
+
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,513 @@
+#include "delta_functions.hpp"
+#include "functions/delta_query_cache.hpp"
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+#include "functions/delta_scan/delta_scan.hpp"
+#include "storage/delta_table_entry.hpp"
+#include "storage/delta_transaction.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/scalar_function_catalog_entry.hpp"
+#include "duckdb/common/set.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/parser/expression/subquery_expression.hpp"
+#include "duckdb/parser/parsed_expression_iterator.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+#include "duckdb/parser/tableref/basetableref.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/transaction/meta_transaction.hpp"
+
+namespace duckdb {
+
+shared_ptr<DeltaQueryCache> DeltaQueryCache::Get(ClientContext &context) {
+	return ObjectCache::GetObjectCache(context).GetOrCreate<DeltaQueryCache>(ObjectType());
+}
+
+shared_ptr<const DeltaCachedResult> DeltaQueryCache::Lookup(const string &key) {
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	lru.splice(lru.begin(), lru, entry->second.lru_position);
+	entry->second.hits++;
+	return entry->second.result;
+}
+
+void DeltaQueryCache::Erase(const string &key) {
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return;
+	}
+	memory_usage -= entry->second.memory_usage;
+	lru.erase(entry->second.lru_position);
+	auto query_key = query_keys.find(entry->second.query);
+	if (query_key != query_keys.end() && query_key->second == key) {
+		query_keys.erase(query_key);
+	}
+	entries.erase(entry);
+}
+
+void DeltaQueryCache::Insert(const string &query, const string &key, set<string> tables,
+                             shared_ptr<const DeltaCachedResult> result, idx_t max_memory) {
+	auto result_memory = result->collection->AllocationSize();
+	if (result_memory > max_memory) {
+		return;
+	}
+
+	lock_guard<mutex> guard(lock);
+	// A result of the same query for other table versions is outdated
+	auto query_key = query_keys.find(query);
+	if (query_key != query_keys.end()) {
+		Erase(query_key->second);
+	}
+	Erase(key);
+
+	EvictInternal(max_memory - result_memory);
+
+	lru.push_front(key);
+	entries[key] = CacheEntry {query, std::move(tables), std::move(result), result_memory, lru.begin(), 0,
+	                           Timestamp::GetCurrentTimestamp()};
+	query_keys[query] = key;
+	memory_usage += result_memory;
+}
+
+void DeltaQueryCache::EvictInternal(idx_t max_memory) {
+	while (!lru.empty() && memory_usage > max_memory) {
+		Erase(lru.back());
+	}
+}
+
+void DeltaQueryCache::Evict(idx_t max_memory) {
+	lock_guard<mutex> guard(lock);
+	EvictInternal(max_memory);
+}
+
+void DeltaQueryCache::ResizeOnSetting(ClientContext &context, SetScope scope, Value &parameter) {
+	// Parsing also rejects invalid sizes before the setting is changed
+	auto max_memory = DBConfig::ParseMemoryLimit(parameter.ToString());
+	DeltaQueryCache::Get(context)->Evict(max_memory);
+}
+
+void DeltaQueryCache::Clear() {
+	lock_guard<mutex> guard(lock);
+	entries.clear();
+	query_keys.clear();
+	lru.clear();
+	memory_usage = 0;
+}
+
+bool DeltaQueryCache::ClearTable(const string &table) {
+	lock_guard<mutex> guard(lock);
+	vector<string> keys;
+	for (auto &entry : entries) {
+		if (entry.second.tables.find(table) != entry.second.tables.end()) {
+			keys.push_back(entry.first);
+		}
+	}
+	for (auto &key : keys) {
+		Erase(key);
+	}
+	return !keys.empty();
+}
+
+idx_t DeltaQueryCache::Count() {
+	lock_guard<mutex> guard(lock);
+	return entries.size();
+}
+
+idx_t DeltaQueryCache::GetMemoryUsage() {
+	lock_guard<mutex> guard(lock);
+	return memory_usage;
+}
+
+vector<DeltaQueryCacheEntryInfo> DeltaQueryCache::GetEntries() {
+	lock_guard<mutex> guard(lock);
+	vector<DeltaQueryCacheEntryInfo> result;
+	for (auto &key : lru) {
+		auto &entry = entries.find(key)->second;
+		result.push_back(DeltaQueryCacheEntryInfo {entry.query, entry.memory_usage, entry.hits, entry.created});
+	}
+	return result;
+}
+
+//! The cache key of a query, with the snapshots of the Delta tables it reads in the transaction of the caller. The
+//! query is executed on these snapshots, so that its result belongs to the versions in the key
+struct DeltaCachedQueryKey {
+	string query;
+	string normalized_query;
+	string key;
+	//! The catalog names or paths of the tables read by the query
+	set<string> tables;
+	//! The snapshots of the delta_scan calls, by path
+	unordered_map<string, shared_ptr<DeltaMultiFileList>> snapshots;
+	//! The table entries of the attached Delta tables, by catalog name
+	unordered_map<string, shared_ptr<DeltaTableEntry>> table_entries;
+};
+
+//! Hands the key computed by the bind_replace of delta_cached_query over to its bind
+class DeltaCachedQueryState : public ClientContextState {
+public:
+	static constexpr const char *NAME = "delta_cached_query";
+
+	void Put(shared_ptr<DeltaCachedQueryKey> cache_key) {
+		lock_guard<mutex> guard(lock);
+		pending[cache_key->query] = std::move(cache_key);
+	}
+	shared_ptr<DeltaCachedQueryKey> Take(const string &query) {
+		lock_guard<mutex> guard(lock);
+		auto entry = pending.find(query);
+		if (entry == pending.end()) {
+			return nullptr;
+		}
+		auto result = std::move(entry->second);
+		pending.erase(entry);
+		return result;
+	}
+
+private:
+	mutex lock;
+	unordered_map<string, shared_ptr<DeltaCachedQueryKey>> pending;
+};
+
+//! Determines whether a query can be cached, and collects the versions and snapshots of the Delta tables it reads
+struct DeltaQueryCacheKeyBuilder {
+	explicit DeltaQueryCacheKeyBuilder(ClientContext &context_p) : context(context_p) {
+	}
+
+	ClientContext &context;
+	bool cacheable = true;
+	//! Whether the table references are resolved, the first pass only collects the names of the CTEs
+	bool resolve = false;
+	unordered_set<string> cte_names;
+	//! The tables read by the query with their versions, ordered to make the key deterministic
+	set<string> table_versions;
+	//! The catalog names or paths of the tables read by the query
+	set<string> tables;
+	unordered_map<string, shared_ptr<DeltaMultiFileList>> snapshots;
+	unordered_map<string, shared_ptr<DeltaTableEntry>> table_entries;
+
+	void VisitNode(QueryNode &node) {
+		for (auto &cte : node.cte_map.map) {
+			cte_names.insert(StringUtil::Lower(cte.first));
+			VisitNode(*cte.second->query->node);
+		}
+		ParsedExpressionIterator::EnumerateQueryNodeChildren(
+		    node, [&](unique_ptr<ParsedExpression> &child) { VisitExpression(*child); },
+		    [&](TableRef &ref) { VisitTableRef(ref); });
+	}
+
+	void VisitExpression(ParsedExpression &expr) {
+		switch (expr.GetExpressionClass()) {
+		case ExpressionClass::SUBQUERY:
+			VisitNode(*expr.Cast<SubqueryExpression>().subquery->node);
+			break;
+		case ExpressionClass::FUNCTION:
+			if (resolve) {
+				VisitFunction(expr.Cast<FunctionExpression>());
+			}
+			break;
+		default:
+			break;
+		}
+		ParsedExpressionIterator::EnumerateChildren(expr,
+		                                            [&](ParsedExpression &child) { VisitExpression(child); });
+	}
+
+	void VisitFunction(FunctionExpression &function) {
+		// Functions that are not consistent (e.g. random() or now()) make the result depend on more than the versions
+		auto entry = Catalog::GetEntry(context, CatalogType::SCALAR_FUNCTION_ENTRY, function.catalog, function.schema,
+		                               function.function_name, OnEntryNotFound::RETURN_NULL);
+		if (!entry || entry->type != CatalogType::SCALAR_FUNCTION_ENTRY) {
+			return;
+		}
+		for (auto &overload : entry->Cast<ScalarFunctionCatalogEntry>().functions.functions) {
+			if (overload.stability != FunctionStability::CONSISTENT) {
+				cacheable = false;
+			}
+		}
+	}
+
+	void VisitTableRef(TableRef &ref) {
+		switch (ref.type) {
+		case TableReferenceType::SUBQUERY:
+			for (auto &cte : ref.Cast<SubqueryRef>().subquery->node->cte_map.map) {
+				cte_names.insert(StringUtil::Lower(cte.first));
+			}
+			break;
+		case TableReferenceType::BASE_TABLE:
+			if (resolve) {
+				VisitBaseTable(ref.Cast<BaseTableRef>());
+			}
+			break;
+		case TableReferenceType::TABLE_FUNCTION:
+			if (resolve) {
+				VisitTableFunction(ref.Cast<TableFunctionRef>());
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void VisitBaseTable(BaseTableRef &ref) {
+		if (ref.catalog_name.empty() && ref.schema_name.empty() &&
+		    cte_names.find(StringUtil::Lower(ref.table_name)) != cte_names.end()) {
+			return;
+		}
+		auto entry = Catalog::GetEntry(context, CatalogType::TABLE_ENTRY, ref.catalog_name, ref.schema_name,
+		                               ref.table_name, OnEntryNotFound::RETURN_NULL);
+		if (!entry && ref.catalog_name.empty() && ref.schema_name.empty()) {
+			// A bare name can refer to the table of an attached Delta table
+			entry = Catalog::GetEntry(context, CatalogType::TABLE_ENTRY, ref.table_name, DEFAULT_SCHEMA,
+			                          ref.table_name, OnEntryNotFound::RETURN_NULL);
+		}
+		// Only Delta tables are immutable per version
+		if (!entry || entry->type != CatalogType::TABLE_ENTRY || entry->ParentCatalog().GetCatalogType() != "delta") {
+			cacheable = false;
+			return;
+		}
+		auto &table = entry->Cast<DeltaTableEntry>();
+		auto &catalog = entry->ParentCatalog();
+		table_versions.insert(StringUtil::Format("%s@%llu", catalog.GetName(), table.snapshot->GetVersion()));
+		tables.insert(catalog.GetName());
+		table_entries[catalog.GetName()] = DeltaTransaction::Get(context, catalog).GetSharedTableEntry();
+	}
+
+	void VisitTableFunction(TableFunctionRef &ref) {
+		if (ref.function->GetExpressionClass() != ExpressionClass::FUNCTION) {
+			cacheable = false;
+			return;
+		}
+		auto &function = ref.function->Cast<FunctionExpression>();
+		if (function.function_name != "delta_scan" || function.children.empty() ||
+		    function.children[0]->GetExpressionClass() != ExpressionClass::CONSTANT) {
+			cacheable = false;
+			return;
+		}
+		auto path = function.children[0]->Cast<ConstantExpression>().value.ToString();
+
+		auto snapshot = make_shared_ptr<DeltaMultiFileList>(context, path);
+		auto version = snapshot->GetVersion();
+		table_versions.insert(StringUtil::Format("%s@%llu", snapshot->GetPath(), version));
+		tables.insert(snapshot->GetPath());
+		snapshots[snapshot->GetPath()] = std::move(snapshot);
+	}
+
+	//! Returns the key of the query, or an empty string if it can not be cached
+	string GetKey(const string &normalized_query, QueryNode &node) {
+		VisitNode(node);
+		resolve = true;
+		VisitNode(node);
+		if (!cacheable) {
+			return string();
+		}
+		string key = normalized_query;
+		for (auto &table_version : table_versions) {
+			key += "\n" + table_version;
+		}
+		return key;
+	}
+};
+
+struct DeltaCachedQueryBindData : public TableFunctionData {
+	//! The cached result, only set on a cache hit
+	shared_ptr<const DeltaCachedResult> result;
+	//! The key and snapshots the query is executed with on a cache miss
+	shared_ptr<DeltaCachedQueryKey> cache_key;
+	vector<LogicalType> types;
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto copy = make_uniq<DeltaCachedQueryBindData>();
+		copy->result = result;
+		copy->cache_key = cache_key;
+		copy->types = types;
+		return std::move(copy);
+	}
+	bool Equals(const FunctionData &other) const override {
+		auto &other_data = other.Cast<DeltaCachedQueryBindData>();
+		return result == other_data.result && cache_key == other_data.cache_key;
+	}
+};
+
+struct DeltaCachedQueryGlobalState : public GlobalTableFunctionState {
+	shared_ptr<const DeltaCachedResult> result;
+	ColumnDataScanState scan_state;
+};
+
+static idx_t GetMaxCacheMemory(ClientContext &context) {
+	Value result;
+	if (context.TryGetCurrentSetting(DeltaQueryCache::SETTING_NAME, result)) {
+		return DBConfig::ParseMemoryLimit(result.ToString());
+	}
+	return 0;
+}
+
+static unique_ptr<SelectStatement> ParseCachedQuery(ClientContext &context, const string &query) {
+	Parser parser(context.GetParserOptions());
+	parser.ParseQuery(query);
+	if (parser.statements.size() != 1 || parser.statements[0]->type != StatementType::SELECT_STATEMENT) {
+		throw BinderException("delta_cached_query only supports a single SELECT statement");
+	}
+	return unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
+}
+
+//! Queries that can not be cached, and queries in a transaction that wrote data, are replaced by a regular subquery
+//! executed in the transaction of the caller
+static unique_ptr<TableRef> DeltaCachedQueryBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	auto query = input.inputs[0].GetValue<string>();
+	auto select = ParseCachedQuery(context, query);
+
+	auto cache_key = make_shared_ptr<DeltaCachedQueryKey>();
+	cache_key->query = query;
+	cache_key->normalized_query = select->ToString();
+	DeltaQueryCacheKeyBuilder key_builder(context);
+	cache_key->key = key_builder.GetKey(cache_key->normalized_query, *select->node);
+	if (cache_key->key.empty() || MetaTransaction::Get(context).ModifiedDatabase()) {
+		return make_uniq<SubqueryRef>(std::move(select));
+	}
+	cache_key->tables = std::move(key_builder.tables);
+	cache_key->snapshots = std::move(key_builder.snapshots);
+	cache_key->table_entries = std::move(key_builder.table_entries);
+	context.registered_state->GetOrCreate<DeltaCachedQueryState>(DeltaCachedQueryState::NAME)->Put(cache_key);
+	return nullptr;
+}
+
+static unique_ptr<FunctionData> DeltaCachedQueryBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	auto query = input.inputs[0].GetValue<string>();
+	auto state = context.registered_state->GetOrCreate<DeltaCachedQueryState>(DeltaCachedQueryState::NAME);
+	auto cache_key = state->Take(query);
+	if (!cache_key) {
+		throw InternalException("delta_cached_query was bound without a cache key");
+	}
+
+	auto bind_data = make_uniq<DeltaCachedQueryBindData>();
+	bind_data->result = DeltaQueryCache::Get(context)->Lookup(cache_key->key);
+	if (bind_data->result) {
+		names = bind_data->result->names;
+		return_types = bind_data->result->types;
+		bind_data->types = return_types;
+		return std::move(bind_data);
+	}
+
+	// On a miss, the query is only bound here (on the snapshots of the key) to get its result types. It is executed
+	// when the scan is initialized
+	auto registry = context.registered_state->GetOrCreate<DeltaSnapshotRegistry>(DeltaSnapshotRegistry::NAME);
+	for (auto &snapshot : cache_key->snapshots) {
+		registry->Register(snapshot.first, snapshot.second);
+	}
+	try {
+		auto select = ParseCachedQuery(context, query);
+		SQLStatement &statement = *select;
+		auto binder = Binder::CreateBinder(context);
+		auto bound_query = binder->Bind(statement);
+		names = bound_query.names;
+		return_types = bound_query.types;
+	} catch (...) {
+		for (auto &snapshot : cache_key->snapshots) {
+			registry->Unregister(snapshot.first);
+		}
+		throw;
+	}
+	for (auto &snapshot : cache_key->snapshots) {
+		registry->Unregister(snapshot.first);
+	}
+	bind_data->cache_key = std::move(cache_key);
+	bind_data->types = return_types;
+	return std::move(bind_data);
+}
+
+//! Executes the query on a separate connection whose transaction reads the same Delta snapshots as the caller, and
+//! adds the result to the cache
+static shared_ptr<const DeltaCachedResult> ExecuteCachedQuery(ClientContext &context,
+                                                              const DeltaCachedQueryKey &cache_key,
+                                                              const vector<LogicalType> &types) {
+	Connection con(*context.db);
+	auto registry = con.context->registered_state->GetOrCreate<DeltaSnapshotRegistry>(DeltaSnapshotRegistry::NAME);
+	for (auto &snapshot : cache_key.snapshots) {
+		registry->Register(snapshot.first, snapshot.second);
+	}
+
+	unique_ptr<MaterializedQueryResult> query_result;
+	con.BeginTransaction();
+	try {
+		con.context->RunFunctionInTransaction([&]() {
+			for (auto &table_entry : cache_key.table_entries) {
+				auto &catalog = Catalog::GetCatalog(*con.context, table_entry.first);
+				DeltaTransaction::Get(*con.context, catalog).SetTableEntry(table_entry.second);
+			}
+		});
+		query_result = con.Query(cache_key.query);
+		if (query_result->HasError()) {
+			query_result->ThrowError();
+		}
+		con.Commit();
+	} catch (...) {
+		con.Rollback();
+		throw;
+	}
+	if (query_result->types != types) {
+		throw InvalidInputException("delta_cached_query: the result types of '%s' changed since it was bound",
+		                            cache_key.query);
+	}
+
+	auto result = make_shared_ptr<DeltaCachedResult>();
+	result->names = query_result->names;
+	result->types = query_result->types;
+	result->collection = query_result->TakeCollection();
+	DeltaQueryCache::Get(context)->Insert(cache_key.normalized_query, cache_key.key, cache_key.tables, result,
+	                                      GetMaxCacheMemory(context));
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> DeltaCachedQueryInit(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<DeltaCachedQueryBindData>();
+	auto result = make_uniq<DeltaCachedQueryGlobalState>();
+	result->result = bind_data.result;
+	if (!result->result) {
+		result->result = ExecuteCachedQuery(context, *bind_data.cache_key, bind_data.types);
+	}
+	result->result->collection->InitializeScan(result->scan_state);
+	return std::move(result);
+}
+
+static void DeltaCachedQueryFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<DeltaCachedQueryGlobalState>();
+	state.result->collection->Scan(state.scan_state, output);
+}
+
+static InsertionOrderPreservingMap<string> DeltaCachedQueryToString(TableFunctionToStringInput &input) {
+	InsertionOrderPreservingMap<string> result;
+	if (!input.bind_data) {
+		return result;
+	}
+	auto &bind_data = input.bind_data->Cast<DeltaCachedQueryBindData>();
+	result["Cache"] = bind_data.result ? "hit" : "miss";
+	return result;
+}
+
+TableFunctionSet DeltaFunctions::GetDeltaCachedQueryFunction(DatabaseInstance &instance) {
+	TableFunctionSet result("delta_cached_query");
+
+	TableFunction function({LogicalType::VARCHAR}, DeltaCachedQueryFunction, DeltaCachedQueryBind,
+	                       DeltaCachedQueryInit);
+	function.bind_replace = DeltaCachedQueryBindReplace;
+	function.to_string = DeltaCachedQueryToString;
+	result.AddFunction(function);
+
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,567 @@
+#include "delta_functions.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
+
+namespace duckdb {
+
+//! Magic number that prefixes a serialized RoaringBitmapArray in the Delta deletion vector format
+static constexpr uint32_t DELETION_VECTOR_MAGIC = 1681511377;
+//! Portable roaring format cookie for bitmaps without run containers
+static constexpr uint32_t ROARING_SERIAL_COOKIE_NO_RUNCONTAINER = 12346;
+//! Containers with more values than this are serialized as bitsets
+static constexpr idx_t ROARING_ARRAY_CONTAINER_MAX = 4096;
+//! Number of files buffered before they are flushed to the checkpoint staging table
+static constexpr idx_t CHECKPOINT_STAGING_BATCH_SIZE = 1000;
+
+static constexpr auto CHECKPOINT_PROTOCOL_TYPE =
+    "STRUCT(minReaderVersion INTEGER, minWriterVersion INTEGER, readerFeatures VARCHAR[], writerFeatures VARCHAR[])";
+static constexpr auto CHECKPOINT_METADATA_TYPE =
+    "STRUCT(id VARCHAR, name VARCHAR, description VARCHAR, format STRUCT(provider VARCHAR, options MAP(VARCHAR, "
+    "VARCHAR)), schemaString VARCHAR, partitionColumns VARCHAR[], configuration MAP(VARCHAR, VARCHAR), createdTime "
+    "BIGINT)";
+static constexpr auto CHECKPOINT_ADD_TYPE =
+    "STRUCT(path VARCHAR, partitionValues MAP(VARCHAR, VARCHAR), size BIGINT, modificationTime BIGINT, dataChange "
+    "BOOLEAN, stats VARCHAR, tags MAP(VARCHAR, VARCHAR), deletionVector STRUCT(storageType VARCHAR, pathOrInlineDv "
+    "VARCHAR, \"offset\" INTEGER, sizeInBytes INTEGER, cardinality BIGINT))";
+
+struct DeltaGenerateBindData : public TableFunctionData {
+	string path;
+	//! Total number of data files in the table
+	idx_t file_count = 10;
+	//! Number of commits the files are spread over
+	idx_t commit_count = 1;
+	//! Write a checkpoint every N commits (0 disables checkpointing)
+	idx_t checkpoint_interval = 0;
+	//! Number of distinct values of the partition column (0 means unpartitioned)
+	idx_t partition_count = 0;
+	idx_t rows_per_file = 1000;
+	//! Number of BIGINT value columns next to the id column
+	idx_t value_columns = 1;
+	//! Fraction of rows per file that is deleted through a deletion vector
+	double dv_density = 0;
+	//! Whether to write file statistics to the add actions
+	bool write_stats = true;
+	//! Skip generation if a delta log already exists at the path
+	bool if_not_exists = false;
+	//! Add the files in new commits to an existing table generated with the same options
+	bool append = false;
+};
+
+struct DeltaGenerateGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+struct DeltaGeneratedFile {
+	string path;
+	idx_t partition_value;
+	idx_t size;
+	string stats;
+	string dv_inline;
+	idx_t dv_size;
+	idx_t dv_cardinality;
+};
+
+static void WriteLE16(string &out, uint16_t value) {
+	out.push_back(static_cast<char>(value & 0xFF));
+	out.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+static void WriteLE32(string &out, uint32_t value) {
+	for (idx_t i = 0; i < 4; i++) {
+		out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+	}
+}
+
+static void WriteLE64(string &out, uint64_t value) {
+	for (idx_t i = 0; i < 8; i++) {
+		out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+	}
+}
+
+//! Serialize the (sorted) row indexes into the Delta RoaringBitmapArray format
+static string SerializeDeletionVector(const vector<uint32_t> &rows) {
+	vector<pair<uint16_t, vector<uint16_t>>> containers;
+	for (auto row : rows) {
+		auto key = static_cast<uint16_t>(row >> 16);
+		if (containers.empty() || containers.back().first != key) {
+			containers.emplace_back(key, vector<uint16_t>());
+		}
+		containers.back().second.push_back(static_cast<uint16_t>(row & 0xFFFF));
+	}
+
+	string bitmap;
+	WriteLE32(bitmap, ROARING_SERIAL_COOKIE_NO_RUNCONTAINER);
+	WriteLE32(bitmap, static_cast<uint32_t>(containers.size()));
+	for (auto &container : containers) {
+		WriteLE16(bitmap, container.first);
+		WriteLE16(bitmap, static_cast<uint16_t>(container.second.size() - 1));
+	}
+	auto offset = static_cast<uint32_t>(8 + 8 * containers.size());
+	for (auto &container : containers) {
+		WriteLE32(bitmap, offset);
+		offset += container.second.size() > ROARING_ARRAY_CONTAINER_MAX ? 8192 : 2 * container.second.size();
+	}
+	for (auto &container : containers) {
+		if (container.second.size() > ROARING_ARRAY_CONTAINER_MAX) {
+			vector<uint64_t> bits(1024, 0);
+			for (auto value : container.second) {
+				bits[value / 64] |= uint64_t(1) << (value % 64);
+			}
+			for (auto word : bits) {
+				WriteLE64(bitmap, word);
+			}
+		} else {
+			for (auto value : container.second) {
+				WriteLE16(bitmap, value);
+			}
+		}
+	}
+
+	string result;
+	WriteLE32(result, DELETION_VECTOR_MAGIC);
+	// A single 32-bit bitmap with high bits 0 covers all row indexes of a generated file
+	WriteLE64(result, 1);
+	WriteLE32(result, 0);
+	result += bitmap;
+	return result;
+}
+
+static string EncodeZ85(string data) {
+	static constexpr const char *Z85_ALPHABET =
+	    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+	while (data.size() % 4 != 0) {
+		data.push_back('\0');
+	}
+	string result;
+	result.reserve(data.size() / 4 * 5);
+	for (idx_t i = 0; i < data.size(); i += 4) {
+		uint32_t value = 0;
+		for (idx_t j = 0; j < 4; j++) {
+			value = (value << 8) | static_cast<uint8_t>(data[i + j]);
+		}
+		char chars[5];
+		for (idx_t j = 5; j > 0; j--) {
+			chars[j - 1] = Z85_ALPHABET[value % 85];
+			value /= 85;
+		}
+		result.append(chars, 5);
+	}
+	return result;
+}
+
+static string EscapeJSON(const string &input) {
+	string result;
+	result.reserve(input.size());
+	for (auto c : input) {
+		if (c == '"' || c == '\\') {
+			result.push_back('\\');
+		}
+		result.push_back(c);
+	}
+	return result;
+}
+
+static string EscapeSQL(const string &input) {
+	return StringUtil::Replace(input, "'", "''");
+}
+
+static vector<string> GetValueColumnNames(const DeltaGenerateBindData &data) {
+	vector<string> result;
+	for (idx_t i = 0; i < data.value_columns; i++) {
+		result.push_back("c" + to_string(i));
+	}
+	return result;
+}
+
+static string GetSchemaString(const DeltaGenerateBindData &data) {
+	vector<string> fields;
+	fields.push_back(R"({"name":"id","type":"long","nullable":true,"metadata":{}})");
+	for (auto &name : GetValueColumnNames(data)) {
+		fields.push_back(StringUtil::Format(R"({"name":"%s","type":"long","nullable":true,"metadata":{}})", name));
+	}
+	if (data.partition_count > 0) {
+		fields.push_back(R"({"name":"part","type":"long","nullable":true,"metadata":{}})");
+	}
+	return StringUtil::Format(R"({"type":"struct","fields":[%s]})", StringUtil::Join(fields, ","));
+}
+
+static string GetStatsString(const DeltaGenerateBindData &data, idx_t first_row) {
+	if (!data.write_stats) {
+		return string();
+	}
+	auto last_row = first_row + data.rows_per_file - 1;
+	vector<string> min_values {StringUtil::Format(R"("id":%llu)", first_row)};
+	vector<string> max_values {StringUtil::Format(R"("id":%llu)", last_row)};
+	vector<string> null_counts {R"("id":0)"};
+	auto value_columns = GetValueColumnNames(data);
+	for (idx_t i = 0; i < value_columns.size(); i++) {
+		min_values.push_back(StringUtil::Format(R"("%s":%llu)", value_columns[i], first_row + i));
+		max_values.push_back(StringUtil::Format(R"("%s":%llu)", value_columns[i], last_row + i));
+		null_counts.push_back(StringUtil::Format(R"("%s":0)", value_columns[i]));
+	}
+	return StringUtil::Format(R"({"numRecords":%llu,"minValues":{%s},"maxValues":{%s},"nullCount":{%s}})",
+	                          data.rows_per_file, StringUtil::Join(min_values, ","), StringUtil::Join(max_values, ","),
+	                          StringUtil::Join(null_counts, ","));
+}
+
+static bool UsesDeletionVectors(const DeltaGenerateBindData &data) {
+	return static_cast<idx_t>(static_cast<double>(data.rows_per_file) * data.dv_density) > 0;
+}
+
+static string GetProtocolAction(const DeltaGenerateBindData &data) {
+	if (UsesDeletionVectors(data)) {
+		return R"({"protocol":{"minReaderVersion":3,"minWriterVersion":7,"readerFeatures":["deletionVectors"],"writerFeatures":["deletionVectors"]}})";
+	}
+	return R"({"protocol":{"minReaderVersion":1,"minWriterVersion":2}})";
+}
+
+static string GetMetaDataAction(const DeltaGenerateBindData &data, const string &table_id, int64_t timestamp) {
+	auto partition_columns = data.partition_count > 0 ? R"(["part"])" : "[]";
+	auto configuration = UsesDeletionVectors(data) ? R"({"delta.enableDeletionVectors":"true"})" : "{}";
+	return StringUtil::Format(
+	    R"({"metaData":{"id":"%s","format":{"provider":"parquet","options":{}},"schemaString":"%s","partitionColumns":%s,"configuration":%s,"createdTime":%lld}})",
+	    table_id, EscapeJSON(GetSchemaString(data)), partition_columns, configuration, timestamp);
+}
+
+static string GetAddAction(const DeltaGenerateBindData &data, const DeltaGeneratedFile &file, int64_t timestamp) {
+	string partition_values = "{}";
+	if (data.partition_count > 0) {
+		partition_values = StringUtil::Format(R"({"part":"%llu"})", file.partition_value);
+	}
+	string stats;
+	if (!file.stats.empty()) {
+		stats = StringUtil::Format(R"(,"stats":"%s")", EscapeJSON(file.stats));
+	}
+	string deletion_vector;
+	if (!file.dv_inline.empty()) {
+		deletion_vector = StringUtil::Format(
+		    R"(,"deletionVector":{"storageType":"i","pathOrInlineDv":"%s","sizeInBytes":%llu,"cardinality":%llu})",
+		    file.dv_inline, file.dv_size, file.dv_cardinality);
+	}
+	return StringUtil::Format(
+	    R"({"add":{"path":"%s","partitionValues":%s,"size":%llu,"modificationTime":%lld,"dataChange":true%s%s}})",
+	    file.path, partition_values, file.size, timestamp, stats, deletion_vector);
+}
+
+static void WriteFile(FileSystem &fs, const string &path, const string &content) {
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(const_cast<char *>(content.data()), content.size());
+	handle->Sync();
+	handle->Close();
+}
+
+static void RunQuery(Connection &con, const string &query) {
+	auto result = con.Query(query);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+}
+
+static DeltaGeneratedFile WriteDataFile(ClientContext &context, Connection &con, const DeltaGenerateBindData &data,
+                                        idx_t file_idx) {
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	DeltaGeneratedFile file;
+	file.partition_value = data.partition_count > 0 ? file_idx % data.partition_count : 0;
+	auto file_name = StringUtil::Format("part-%05llu.parquet", file_idx);
+	if (data.partition_count > 0) {
+		auto partition_dir = fs.JoinPath(data.path, StringUtil::Format("part=%llu", file.partition_value));
+		if (!fs.DirectoryExists(partition_dir)) {
+			fs.CreateDirectory(partition_dir);
+		}
+		file.path = StringUtil::Format("part=%llu/%s", file.partition_value, file_name);
+	} else {
+		file.path = file_name;
+	}
+	auto full_path = fs.JoinPath(data.path, file.path);
+
+	auto first_row = file_idx * data.rows_per_file;
+	vector<string> select_list {"range AS id"};
+	auto value_columns = GetValueColumnNames(data);
+	for (idx_t i = 0; i < value_columns.size(); i++) {
+		select_list.push_back(StringUtil::Format("range + %llu AS %s", i, value_columns[i]));
+	}
+	RunQuery(con, StringUtil::Format("COPY (SELECT %s FROM range(%llu, %llu)) TO '%s' (FORMAT parquet)",
+	                                 StringUtil::Join(select_list, ", "), first_row, first_row + data.rows_per_file,
+	                                 EscapeSQL(full_path)));
+
+	file.size = fs.OpenFile(full_path, FileFlags::FILE_FLAGS_READ)->GetFileSize();
+	file.stats = GetStatsString(data, first_row);
+
+	// Spread the deleted rows evenly over the file
+	auto deleted_count = static_cast<idx_t>(static_cast<double>(data.rows_per_file) * data.dv_density);
+	file.dv_size = 0;
+	file.dv_cardinality = deleted_count;
+	if (deleted_count > 0) {
+		vector<uint32_t> deleted_rows;
+		deleted_rows.reserve(deleted_count);
+		for (idx_t i = 0; i < data.rows_per_file; i++) {
+			if ((i + 1) * deleted_count / data.rows_per_file > i * deleted_count / data.rows_per_file) {
+				deleted_rows.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		auto serialized = SerializeDeletionVector(deleted_rows);
+		file.dv_size = serialized.size();
+		file.dv_inline = EncodeZ85(std::move(serialized));
+	}
+	return file;
+}
+
+static void FlushCheckpointStaging(Connection &con, const vector<DeltaGeneratedFile> &files, idx_t version) {
+	if (files.empty()) {
+		return;
+	}
+	vector<string> rows;
+	for (auto &file : files) {
+		auto stats = file.stats.empty() ? "NULL" : "'" + EscapeSQL(file.stats) + "'";
+		auto dv = file.dv_inline.empty() ? "NULL" : "'" + file.dv_inline + "'";
+		rows.push_back(StringUtil::Format("(%llu, '%s', %llu, %llu, %s, %s, %llu, %llu)", version, EscapeSQL(file.path),
+		                                  file.partition_value, file.size, stats, dv, file.dv_size,
+		                                  file.dv_cardinality));
+	}
+	RunQuery(con, "INSERT INTO delta_generate_files VALUES " + StringUtil::Join(rows, ", "));
+}
+
+static void WriteCheckpoint(ClientContext &context, Connection &con, const DeltaGenerateBindData &data,
+                            const string &table_id, idx_t version, int64_t timestamp, idx_t file_count) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto log_dir = fs.JoinPath(data.path, "_delta_log");
+	auto checkpoint_path = fs.JoinPath(log_dir, StringUtil::Format("%020llu.checkpoint.parquet", version));
+
+	auto uses_dvs = UsesDeletionVectors(data);
+	auto protocol =
+	    uses_dvs ? "{'minReaderVersion': 3, 'minWriterVersion': 7, 'readerFeatures': ['deletionVectors'], "
+	               "'writerFeatures': ['deletionVectors']}"
+	             : "{'minReaderVersion': 1, 'minWriterVersion': 2, 'readerFeatures': NULL, 'writerFeatures': NULL}";
+	auto metadata = StringUtil::Format(
+	    "{'id': '%s', 'name': NULL, 'description': NULL, 'format': {'provider': 'parquet', 'options': MAP {}}, "
+	    "'schemaString': '%s', 'partitionColumns': %s, 'configuration': %s, 'createdTime': %lld}",
+	    table_id, EscapeSQL(GetSchemaString(data)), data.partition_count > 0 ? "['part']" : "[]::VARCHAR[]",
+	    uses_dvs ? "MAP {'delta.enableDeletionVectors': 'true'}" : "MAP {}", timestamp);
+	auto partition_values = data.partition_count > 0 ? "MAP {'part': part::VARCHAR}" : "MAP {}";
+	auto add = StringUtil::Format(
+	    "{'path': path, 'partitionValues': %s, 'size': size, 'modificationTime': %lld, 'dataChange': false, 'stats': "
+	    "stats, 'tags': NULL, 'deletionVector': CASE WHEN dv IS NULL THEN NULL ELSE {'storageType': 'i', "
+	    "'pathOrInlineDv': dv, 'offset': NULL, 'sizeInBytes': dv_size, 'cardinality': dv_cardinality} END}",
+	    partition_values, timestamp);
+
+	RunQuery(con, StringUtil::Format("COPY (SELECT %s::%s AS protocol, NULL::%s AS metaData, NULL::%s AS add "
+	                                 "UNION ALL SELECT NULL, %s::%s, NULL "
+	                                 "UNION ALL SELECT NULL, NULL, %s::%s FROM delta_generate_files WHERE version <= %llu"
+	                                 ") TO '%s' (FORMAT parquet)",
+	                                 protocol, CHECKPOINT_PROTOCOL_TYPE, CHECKPOINT_METADATA_TYPE, CHECKPOINT_ADD_TYPE,
+	                                 metadata, CHECKPOINT_METADATA_TYPE, add, CHECKPOINT_ADD_TYPE, version,
+	                                 EscapeSQL(checkpoint_path)));
+
+	auto last_checkpoint_path = fs.JoinPath(log_dir, "_last_checkpoint");
+	if (fs.FileExists(last_checkpoint_path)) {
+		fs.RemoveFile(last_checkpoint_path);
+	}
+	WriteFile(fs, last_checkpoint_path,
+	          StringUtil::Format(R"({"version":%llu,"size":%llu})", version, file_count + 2));
+}
+
+//! The version after the latest commit in the log
+static idx_t GetNextVersion(FileSystem &fs, const string &log_dir) {
+	idx_t next_version = 0;
+	for (auto &file : fs.Glob(fs.JoinPath(log_dir, "*.json"))) {
+		auto version = std::stoull(fs.ExtractBaseName(file.path));
+		next_version = MaxValue<idx_t>(next_version, version + 1);
+	}
+	return next_version;
+}
+
+//! The index after the highest index of the data files written by delta_generate
+static idx_t GetNextFileIndex(FileSystem &fs, const string &path) {
+	idx_t next_file_idx = 0;
+	auto files = fs.Glob(fs.JoinPath(path, "part-*.parquet"));
+	auto partitioned_files = fs.Glob(fs.JoinPath(fs.JoinPath(path, "part=*"), "part-*.parquet"));
+	files.insert(files.end(), partitioned_files.begin(), partitioned_files.end());
+	for (auto &file : files) {
+		auto file_idx = std::stoull(fs.ExtractBaseName(file.path).substr(5));
+		next_file_idx = MaxValue<idx_t>(next_file_idx, file_idx + 1);
+	}
+	return next_file_idx;
+}
+
+static unique_ptr<FunctionData> DeltaGenerateBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<DeltaGenerateBindData>();
+	result->path = input.inputs[0].GetValue<string>();
+
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		if (loption == "stats") {
+			result->write_stats = kv.second.GetValue<bool>();
+			continue;
+		}
+		if (loption == "if_not_exists") {
+			result->if_not_exists = kv.second.GetValue<bool>();
+			continue;
+		}
+		if (loption == "append") {
+			result->append = kv.second.GetValue<bool>();
+			continue;
+		}
+		if (loption == "dv_density") {
+			result->dv_density = kv.second.GetValue<double>();
+			if (result->dv_density < 0 || result->dv_density > 1) {
+				throw InvalidInputException("delta_generate: 'dv_density' must be between 0 and 1");
+			}
+			continue;
+		}
+		auto value = kv.second.GetValue<int64_t>();
+		if (value < 0) {
+			throw InvalidInputException("delta_generate: '%s' can not be negative", kv.first);
+		}
+		if (loption == "files") {
+			result->file_count = value;
+		} else if (loption == "commits") {
+			result->commit_count = value;
+		} else if (loption == "checkpoint_interval") {
+			result->checkpoint_interval = value;
+		} else if (loption == "partitions") {
+			result->partition_count = value;
+		} else if (loption == "rows_per_file") {
+			result->rows_per_file = value;
+		} else if (loption == "columns") {
+			result->value_columns = value;
+		}
+	}
+	if (result->commit_count == 0) {
+		throw InvalidInputException("delta_generate: 'commits' must be at least 1");
+	}
+	if (result->append && result->checkpoint_interval > 0) {
+		throw InvalidInputException("delta_generate: 'checkpoint_interval' is not supported with 'append'");
+	}
+	if (result->rows_per_file == 0) {
+		throw InvalidInputException("delta_generate: 'rows_per_file' must be at least 1");
+	}
+	if (result->rows_per_file > NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("delta_generate: 'rows_per_file' can not exceed %llu",
+		                            NumericLimits<uint32_t>::Maximum());
+	}
+
+	names.emplace_back("version");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("files");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("checkpoints");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> DeltaGenerateInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<DeltaGenerateGlobalState>();
+}
+
+static void DeltaGenerateFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DeltaGenerateBindData>();
+	auto &state = data_p.global_state->Cast<DeltaGenerateGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto log_dir = fs.JoinPath(data.path, "_delta_log");
+	idx_t first_version = 0;
+	idx_t first_file_idx = 0;
+	if (fs.FileExists(fs.JoinPath(log_dir, StringUtil::Format("%020llu.json", idx_t(0))))) {
+		if (data.append) {
+			first_version = GetNextVersion(fs, log_dir);
+			first_file_idx = GetNextFileIndex(fs, data.path);
+		} else if (data.if_not_exists) {
+			return;
+		} else {
+			throw InvalidInputException("delta_generate: a Delta table already exists at '%s'", data.path);
+		}
+	} else if (data.append) {
+		throw InvalidInputException("delta_generate: there is no Delta table to append to at '%s'", data.path);
+	}
+	if (!fs.DirectoryExists(data.path)) {
+		fs.CreateDirectory(data.path);
+	}
+	if (!fs.DirectoryExists(log_dir)) {
+		fs.CreateDirectory(log_dir);
+	}
+
+	// The data and checkpoint files are written through a separate connection, so we don't interfere with the
+	// query that is currently running in this context
+	Connection con(*context.db);
+	if (data.checkpoint_interval > 0) {
+		RunQuery(con, "CREATE TEMPORARY TABLE delta_generate_files (version BIGINT, path VARCHAR, part BIGINT, size "
+		              "BIGINT, stats VARCHAR, dv VARCHAR, dv_size INTEGER, dv_cardinality BIGINT)");
+	}
+
+	auto table_id = UUID::ToString(UUID::GenerateRandomUUID());
+	auto timestamp = Timestamp::GetEpochMs(Timestamp::GetCurrentTimestamp());
+
+	idx_t files_written = 0;
+	idx_t checkpoints_written = 0;
+	for (idx_t commit_idx = 0; commit_idx < data.commit_count; commit_idx++) {
+		auto version = first_version + commit_idx;
+		vector<string> actions;
+		actions.push_back(StringUtil::Format(
+		    R"({"commitInfo":{"timestamp":%lld,"operation":"WRITE","operationParameters":{"mode":"Append"},"engineInfo":"duckdb-delta-generator"}})",
+		    timestamp));
+		if (version == 0) {
+			actions.push_back(GetProtocolAction(data));
+			actions.push_back(GetMetaDataAction(data, table_id, timestamp));
+		}
+
+		vector<DeltaGeneratedFile> staged_files;
+		auto files_in_commit = (commit_idx + 1) * data.file_count / data.commit_count - files_written;
+		for (idx_t i = 0; i < files_in_commit; i++) {
+			auto file = WriteDataFile(context, con, data, first_file_idx + files_written++);
+			actions.push_back(GetAddAction(data, file, timestamp));
+			if (data.checkpoint_interval > 0) {
+				staged_files.push_back(std::move(file));
+				if (staged_files.size() >= CHECKPOINT_STAGING_BATCH_SIZE) {
+					FlushCheckpointStaging(con, staged_files, version);
+					staged_files.clear();
+				}
+			}
+		}
+		FlushCheckpointStaging(con, staged_files, version);
+
+		WriteFile(fs, fs.JoinPath(log_dir, StringUtil::Format("%020llu.json", version)),
+		          StringUtil::Join(actions, "\n") + "\n");
+
+		if (data.checkpoint_interval > 0 && version > 0 && version % data.checkpoint_interval == 0) {
+			WriteCheckpoint(context, con, data, table_id, version, timestamp, files_written);
+			checkpoints_written++;
+		}
+	}
+
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(first_version + data.commit_count - 1)));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(files_written)));
+	output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(checkpoints_written)));
+	output.SetCardinality(1);
+}
+
+TableFunctionSet DeltaFunctions::GetDeltaGenerateFunction(DatabaseInstance &instance) {
+	TableFunctionSet result("delta_generate");
+
+	TableFunction function({LogicalType::VARCHAR}, DeltaGenerateFunction, DeltaGenerateBind, DeltaGenerateInit);
+	function.named_parameters["files"] = LogicalType::BIGINT;
+	function.named_parameters["commits"] = LogicalType::BIGINT;
+	function.named_parameters["checkpoint_interval"] = LogicalType::BIGINT;
+	function.named_parameters["partitions"] = LogicalType::BIGINT;
+	function.named_parameters["rows_per_file"] = LogicalType::BIGINT;
+	function.named_parameters["columns"] = LogicalType::BIGINT;
+	function.named_parameters["dv_density"] = LogicalType::DOUBLE;
+	function.named_parameters["stats"] = LogicalType::BOOLEAN;
+	function.named_parameters["if_not_exists"] = LogicalType::BOOLEAN;
+	function.named_parameters["append"] = LogicalType::BOOLEAN;
+	result.AddFunction(function);
+
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,119 @@
+#include "functions/delta_scan/delta_deletion_vector.hpp"
+
+namespace duckdb {
+
+DeltaDeletionVector::DeltaDeletionVector(ffi::KernelBoolSlice selection_vector) : row_count(selection_vector.len) {
+	valid_mask.resize((row_count + 63) / 64, 0);
+	auto block_count = (row_count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	deleted_per_block.resize(block_count, 0);
+	for (idx_t block_idx = 0; block_idx < block_count; block_idx++) {
+		auto start = block_idx * STANDARD_VECTOR_SIZE;
+		auto end = MinValue<idx_t>(start + STANDARD_VECTOR_SIZE, row_count);
+		idx_t deleted = 0;
+		for (idx_t row_idx = start; row_idx < end; row_idx++) {
+			auto is_selected = selection_vector.ptr[row_idx];
+			valid_mask[row_idx / 64] |= uint64_t(is_selected) << (row_idx % 64);
+			if (!is_selected) {
+				deleted_rows_hash = CombineHash(deleted_rows_hash, Hash<uint64_t>(row_idx));
+				deleted++;
+			}
+		}
+		deleted_per_block[block_idx] = deleted;
+		deleted_count += deleted;
+	}
+
+	if (selection_vector.ptr) {
+		ffi::free_bool_slice(selection_vector);
+	}
+}
+
+idx_t DeltaDeletionVector::GetMemoryUsage() const {
+	return valid_mask.size() * sizeof(uint64_t) + deleted_per_block.size() * sizeof(idx_t);
+}
+
+bool DeltaDeletionVector::AllRowsDeleted(idx_t file_row_count) const {
+	// Rows past the end of the deletion vector are never deleted
+	return file_row_count <= row_count && deleted_count == file_row_count;
+}
+
+idx_t DeltaDeletionVector::DeletedInRange(idx_t start, idx_t end) const {
+	end = MinValue<idx_t>(end, row_count);
+	idx_t deleted = 0;
+	idx_t row_idx = start;
+	while (row_idx < end) {
+		auto block_idx = row_idx / STANDARD_VECTOR_SIZE;
+		auto block_start = block_idx * STANDARD_VECTOR_SIZE;
+		auto block_end = MinValue<idx_t>(block_start + STANDARD_VECTOR_SIZE, end);
+		if (row_idx == block_start && block_end == block_start + STANDARD_VECTOR_SIZE) {
+			deleted += deleted_per_block[block_idx];
+		} else if (deleted_per_block[block_idx] > 0) {
+			for (idx_t i = row_idx; i < block_end; i++) {
+				deleted += !IsSelected(i);
+			}
+		}
+		row_idx = block_end;
+	}
+	return deleted;
+}
+
+idx_t DeltaDeletionVector::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) const {
+	if (count == 0) {
+		return 0;
+	}
+	result_sel.Initialize(STANDARD_VECTOR_SIZE);
+
+	auto start = NumericCast<idx_t>(start_row_index);
+	auto deleted = start < row_count ? DeletedInRange(start, start + count) : 0;
+	if (deleted == 0) {
+		// Nothing deleted in this range: select everything
+		for (idx_t i = 0; i < count; i++) {
+			result_sel.set_index(i, i);
+		}
+		return count;
+	}
+	if (deleted == count) {
+		return 0;
+	}
+
+	idx_t current_select = 0;
+	for (idx_t i = 0; i < count; i++) {
+		result_sel.set_index(current_select, i);
+		current_select += IsSelected(i + start);
+	}
+	return current_select;
+}
+
+DeltaDeletionVectorCache::DeltaDeletionVectorCache(BufferManager &buffer_manager) : memory_reservation(buffer_manager) {
+}
+
+shared_ptr<const DeltaDeletionVector> DeltaDeletionVectorCache::Get(const string &path) {
+	lock_guard<mutex> guard(lock);
+	auto entry = deletion_vectors.find(path);
+	if (entry == deletion_vectors.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+void DeltaDeletionVectorCache::Put(const string &path, shared_ptr<const DeltaDeletionVector> deletion_vector) {
+	lock_guard<mutex> guard(lock);
+	auto new_size = memory_reservation.GetSize() + deletion_vector->GetMemoryUsage();
+	auto entry = deletion_vectors.find(path);
+	if (entry != deletion_vectors.end()) {
+		new_size -= entry->second->GetMemoryUsage();
+	}
+	memory_reservation.Resize(new_size);
+	deletion_vectors[path] = std::move(deletion_vector);
+}
+
+idx_t DeltaDeletionVectorCache::Count() {
+	lock_guard<mutex> guard(lock);
+	return deletion_vectors.size();
+}
+
+idx_t DeltaDeletionVectorCache::GetMemoryUsage() {
+	lock_guard<mutex> guard(lock);
+	return memory_reservation.GetSize();
+}
+
+} // namespace duckdb
@@ -12,7 +12,9 @@
 #include "duckdb/optimizer/filter_combiner.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/planner/table_filter.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <regex>
 
@@ -351,6 +353,22 @@ static Value GetPartitionValueFromExpression(const vector<unique_ptr<ParsedExpre
 	return child->Cast<ConstantExpression>().value;
 }
 
+//! Estimate the memory used by the listing of a file: its path, metadata and parsed transform expression
+static idx_t EstimateMetaDataMemory(const OpenFileInfo &file, const DeltaFileMetaData &metadata) {
+	static constexpr idx_t EXPRESSION_MEMORY = 128;
+	idx_t result = sizeof(OpenFileInfo) + sizeof(DeltaFileMetaData) + file.path.size();
+	if (file.extended_info) {
+		result += sizeof(ExtendedOpenFileInfo) + sizeof(Value);
+	}
+	for (auto &partition : metadata.partition_map) {
+		result += partition.first.size() + sizeof(Value) + EXPRESSION_MEMORY;
+	}
+	if (metadata.transform_expression) {
+		result += metadata.transform_expression->size() * EXPRESSION_MEMORY;
+	}
+	return result;
+}
+
 void ScanDataCallBack::VisitCallbackInternal(ffi::NullableCvoid engine_context, ffi::KernelStringSlice path,
                                              int64_t size, const ffi::Stats *stats, const ffi::DvInfo *dv_info,
                                              const ffi::Expression *transform) {
@@ -363,8 +381,17 @@ void ScanDataCallBack::VisitCallbackInternal(ffi::NullableCvoid engine_context,
 
 	path_string = url_decode(path_string);
 
-	// First we append the file to our resolved files
-	snapshot.resolved_files.emplace_back(DeltaMultiFileList::ToDuckDBPath(path_string));
+	// First we append the file to our resolved files. The file size is passed on to the file system so the size does
+	// not have to be requested from the storage again when opening the file
+	OpenFileInfo file_info(DeltaMultiFileList::ToDuckDBPath(path_string));
+	if (snapshot.file_selection && snapshot.file_selection->find(file_info.path) == snapshot.file_selection->end()) {
+		return;
+	}
+	if (size >= 0) {
+		file_info.extended_info = make_shared_ptr<ExtendedOpenFileInfo>();
+		file_info.extended_info->options["file_size"] = Value::UBIGINT(NumericCast<idx_t>(size));
+	}
+	snapshot.resolved_files.push_back(std::move(file_info));
 	snapshot.metadata.emplace_back(make_uniq<DeltaFileMetaData>());
 
 	D_ASSERT(snapshot.resolved_files.size() == snapshot.metadata.size());
@@ -375,29 +402,41 @@ void ScanDataCallBack::VisitCallbackInternal(ffi::NullableCvoid engine_context,
 	if (stats) {
 		snapshot.metadata.back()->cardinality = stats->num_records;
 	}
-
-	// Fetch the deletion vector
-	auto selection_vector_res =
-	    ffi::selection_vector_from_dv(dv_info, snapshot.extern_engine.get(), KernelUtils::ToDeltaString(snapshot.root_path));
-
-	// TODO: remove workaround for https://github.com/duckdb/duckdb-delta/issues/150
-	bool do_workaround = false;
-	if (selection_vector_res.tag == ffi::ExternResult<ffi::KernelBoolSlice>::Tag::Err && selection_vector_res.err._0) {
-		auto error_cast = static_cast<DuckDBEngineError *>(selection_vector_res.err._0);
-		if (error_cast->error_message == "Deletion Vector error: Unknown storage format: ''.") {
-			do_workaround = true;
-		}
+	if (size >= 0) {
+		snapshot.metadata.back()->file_size = NumericCast<idx_t>(size);
 	}
 
-	if (!do_workaround) {
-		ffi::KernelBoolSlice selection_vector;
-		auto res = KernelUtils::TryUnpackResult(selection_vector_res, selection_vector);
-		if (res.HasError()) {
-			context->error = res;
-			return;
+	// Fetch the deletion vector: deletion vectors already fetched for this snapshot (e.g. by the list this one was
+	// created from through filter pushdown) are shared instead of read again
+	auto cached_deletion_vector = snapshot.deletion_vector_cache->Get(path_string);
+	if (cached_deletion_vector) {
+		snapshot.metadata.back()->deletion_vector = std::move(cached_deletion_vector);
+	} else {
+		auto selection_vector_res = ffi::selection_vector_from_dv(dv_info, snapshot.extern_engine.get(),
+		                                                          KernelUtils::ToDeltaString(snapshot.root_path));
+
+		// TODO: remove workaround for https://github.com/duckdb/duckdb-delta/issues/150
+		bool do_workaround = false;
+		if (selection_vector_res.tag == ffi::ExternResult<ffi::KernelBoolSlice>::Tag::Err &&
+		    selection_vector_res.err._0) {
+			auto error_cast = static_cast<DuckDBEngineError *>(selection_vector_res.err._0);
+			if (error_cast->error_message == "Deletion Vector error: Unknown storage format: ''.") {
+				do_workaround = true;
+			}
 		}
-		if (selection_vector.ptr) {
-			snapshot.metadata.back()->selection_vector = selection_vector;
+
+		if (!do_workaround) {
+			ffi::KernelBoolSlice selection_vector;
+			auto res = KernelUtils::TryUnpackResult(selection_vector_res, selection_vector);
+			if (res.HasError()) {
+				context->error = res;
+				return;
+			}
+			if (selection_vector.ptr) {
+				auto deletion_vector = make_shared_ptr<DeltaDeletionVector>(selection_vector);
+				snapshot.deletion_vector_cache->Put(path_string, deletion_vector);
+				snapshot.metadata.back()->deletion_vector = std::move(deletion_vector);
+			}
 		}
 	}
 
@@ -421,8 +460,7 @@ void ScanDataCallBack::VisitCallbackInternal(ffi::NullableCvoid engine_context,
 			    GetPartitionValueFromExpression(*parsed_transformation_expression, partition_id);
 		}
 		snapshot.metadata.back()->partition_map = std::move(constant_map);
-		snapshot.metadata.back()->transform_expression =
-		    std::move(parsed_transformation_expression); // FIXME: currently not used
+		snapshot.metadata.back()->transform_expression = std::move(parsed_transformation_expression);
 	} else {
 		if (!snapshot.partitions.empty()) {
 			context->error = ErrorData(ExceptionType::IO,
@@ -430,6 +468,14 @@ void ScanDataCallBack::VisitCallbackInternal(ffi::NullableCvoid engine_context,
 			return;
 		}
 	}
+
+	// Account for the memory of the listing, this throws if the memory limit is exceeded
+	if (!snapshot.metadata_reservation) {
+		auto &buffer_manager = BufferManager::GetBufferManager(snapshot.context);
+		snapshot.metadata_reservation = make_uniq<DeltaMemoryReservation>(buffer_manager);
+	}
+	auto file_memory = EstimateMetaDataMemory(snapshot.resolved_files.back(), *snapshot.metadata.back());
+	snapshot.metadata_reservation->Resize(snapshot.metadata_reservation->GetSize() + file_memory);
 }
 
 void ScanDataCallBack::VisitCallback(ffi::NullableCvoid engine_context, ffi::KernelStringSlice path, int64_t size,
@@ -569,6 +615,7 @@ void DeltaMultiFileList::InitializeSnapshot() const {
 	if (!snapshot) {
 		snapshot = make_shared_ptr<SharedKernelSnapshot>(
 		    TryUnpackKernelResult(ffi::snapshot(path_slice, extern_engine.get())));
+		deletion_vector_cache = make_shared_ptr<DeltaDeletionVectorCache>(BufferManager::GetBufferManager(context));
 	}
 
 	// Set version
@@ -606,69 +653,82 @@ static void InjectColumnIdentifiers(const vector<string> &names, const vector<Lo
 	}
 }
 
-static vector<MultiFileColumnDefinition> ConstructGlobalColDefs(const vector<string> &names,
-                                                                const vector<LogicalType> &types,
-                                                                const vector<string> &partitions,
-                                                                ffi::SharedScan *scan) {
-	vector<string> physical_names;
-	vector<LogicalType> physical_types;
-	vector<string> logical_names;
-	vector<LogicalType> logical_types;
-	unordered_map<string, string> name_map;
-	unordered_map<string, LogicalType> physical_type_map;
-	unordered_set<string> partition_set;
-
-	for (const auto &partition : partitions) {
-		partition_set.insert(partition);
+static bool HasAllFieldIds(const SchemaVisitor::FieldIdList &field_ids) {
+	for (auto &field_id : field_ids) {
+		// Elements of lists and maps are matched by position, a missing id only matters for the fields within them
+		if ((field_id.id.IsNull() && !field_id.collection_element) || !HasAllFieldIds(field_id.children)) {
+			return false;
+		}
 	}
+	return true;
+}
 
-	auto schema_physical = SchemaVisitor::VisitSnapshotGlobalReadSchema(scan, false);
-	auto schema_logical = SchemaVisitor::VisitSnapshotGlobalReadSchema(scan, true);
+//! The children of a list (its element) or a map (its key and value), in the order of the field ids of the kernel
+static vector<MultiFileColumnDefinition> GetCollectionChildren(const LogicalType &type) {
+	vector<MultiFileColumnDefinition> result;
+	if (type.id() == LogicalTypeId::LIST) {
+		result = MultiFileColumnDefinition::ColumnsFromNamesAndTypes({"element"}, {ListType::GetChildType(type)});
+	} else if (type.id() == LogicalTypeId::MAP) {
+		result = MultiFileColumnDefinition::ColumnsFromNamesAndTypes({"key", "value"},
+		                                                             {MapType::KeyType(type), MapType::ValueType(type)});
+	}
+	return result;
+}
 
-	for (idx_t i = 0; i < schema_physical->size(); i++) {
-		physical_names.push_back((*schema_physical)[i].first);
-		physical_types.push_back((*schema_physical)[i].second);
+static void InjectFieldIds(const SchemaVisitor::FieldIdList &field_ids, MultiFileColumnDefinition &col) {
+	if (col.children.size() != field_ids.size()) {
+		auto collection_children = GetCollectionChildren(col.type);
+		if (collection_children.size() == field_ids.size()) {
+			col.children = std::move(collection_children);
+		}
 	}
-	for (idx_t i = 0; i < schema_logical->size(); i++) {
-		logical_names.push_back((*schema_logical)[i].first);
-		logical_types.push_back((*schema_logical)[i].second);
+	for (idx_t i = 0; i < field_ids.size() && i < col.children.size(); i++) {
+		auto &child = col.children[i];
+		if (!field_ids[i].id.IsNull()) {
+			child.default_expression = make_uniq<ConstantExpression>(Value(child.type));
+			child.identifier = field_ids[i].id;
+		}
+		InjectFieldIds(field_ids[i].children, child);
 	}
+}
+
+static shared_ptr<DeltaPhysicalSchema> LoadPhysicalSchema(const vector<string> &names,
+                                                         const vector<LogicalType> &types,
+                                                         const vector<string> &partitions, ffi::SharedScan *scan) {
+	unordered_set<string> partition_set(partitions.begin(), partitions.end());
+
+	SchemaVisitor::FieldIdList physical_field_ids;
+	auto schema_physical = SchemaVisitor::VisitSnapshotGlobalReadSchema(scan, false, physical_field_ids);
 
+	auto result = make_shared_ptr<DeltaPhysicalSchema>();
+	// With column mapping mode 'id' the physical schema carries the parquet field ids: we let the reader resolve the
+	// columns by field id instead of by physical name
+	result->map_by_field_id = !physical_field_ids.empty() && HasAllFieldIds(physical_field_ids);
+
+	// The kernel scan is not projected, so its logical schema is the schema we bound. The physical schema contains the
+	// same columns in the same order, minus the partition columns.
 	idx_t physical_idx = 0;
-	for (idx_t i = 0; i < logical_names.size(); i++) {
-		auto &logical_name = logical_names[i];
-		if (partition_set.find(logical_name) != partition_set.end()) {
+	for (idx_t i = 0; i < names.size(); i++) {
+		if (partition_set.find(names[i]) != partition_set.end()) {
+			result->names.push_back(names[i]);
+			result->types.push_back(types[i]);
+			result->field_ids.emplace_back();
 			continue;
 		}
-		if (physical_idx >= physical_names.size()) {
+		if (physical_idx >= schema_physical->size()) {
 			throw IOException("Failed to map physical schema to logical");
 		}
-		name_map[logical_names[i]] = physical_names[physical_idx];
-		physical_type_map[logical_names[i]] = physical_types[physical_idx];
-		physical_idx++;
-	}
-
-	vector<string> all_names;
-	vector<LogicalType> all_types;
-	for (idx_t i = 0; i < names.size(); i++) {
-		auto &name = names[i];
-		auto &type = types[i];
-
-		auto lu = name_map.find(name);
-		if (lu != name_map.end()) {
-			all_names.push_back(lu->second);
-			all_types.push_back(physical_type_map[name]);
+		result->names.push_back((*schema_physical)[physical_idx].first);
+		result->types.push_back((*schema_physical)[physical_idx].second);
+		if (result->map_by_field_id) {
+			result->field_ids.push_back(std::move(physical_field_ids[physical_idx]));
 		} else {
-			all_names.push_back(name);
-			all_types.push_back(type);
+			result->field_ids.emplace_back();
 		}
+		physical_idx++;
 	}
 
-	auto global_column_defs = MultiFileColumnDefinition::ColumnsFromNamesAndTypes(names, types);
-
-	InjectColumnIdentifiers(names, types, all_names, all_types, global_column_defs);
-
-	return global_column_defs;
+	return result;
 }
 
 void DeltaMultiFileList::InitializeScan() const {
@@ -719,7 +779,10 @@ void DeltaMultiFileList::InitializeScan() const {
 		}
 	}
 
-	lazy_loaded_schema = ConstructGlobalColDefs(names, types, partitions, scan.get());
+	// Lists created by filter pushdown share the physical schema of the list they were created from
+	if (!physical_schema) {
+		physical_schema = LoadPhysicalSchema(names, types, partitions, scan.get());
+	}
 
 	initialized_scan = true;
 }
@@ -758,17 +821,27 @@ unique_ptr<DeltaMultiFileList> DeltaMultiFileList::PushdownInternal(ClientContex
 	filtered_list->table_filters = std::move(result_filter_set);
 	filtered_list->names = names;
 	filtered_list->types = types;
-	filtered_list->lazy_loaded_schema = lazy_loaded_schema;
+	filtered_list->physical_schema = physical_schema;
+	filtered_list->file_selection = file_selection;
 
 	// Copy over the snapshot, this avoids reparsing metadata
 	{
 		unique_lock<mutex> lck(lock);
 		filtered_list->snapshot = snapshot;
+		filtered_list->deletion_vector_cache = deletion_vector_cache;
 	}
 
 	return filtered_list;
 }
 
+unique_ptr<DeltaMultiFileList> DeltaMultiFileList::SelectFiles(ClientContext &context,
+                                                               shared_ptr<const unordered_set<string>> file_paths) const {
+	TableFilterSet no_new_filters;
+	auto selected_list = PushdownInternal(context, no_new_filters);
+	selected_list->file_selection = std::move(file_paths);
+	return selected_list;
+}
+
 static DeltaFilterPushdownMode GetDeltaFilterPushdownMode(ClientContext &context, const MultiFileOptions &options) {
 	auto res = options.custom_options.find("pushdown_filters");
 	if (res != options.custom_options.end()) {
@@ -803,16 +876,107 @@ unique_ptr<MultiFileList> DeltaMultiFileList::ComplexFilterPushdown(ClientContex
 		return nullptr;
 	}
 
+	string decision = "pushed";
+	if (pushdown_mode == DeltaFilterPushdownMode::ADAPTIVE && !AdaptivePushdown(context, filter_set, decision)) {
+		ReportFilterPushdown(context, nullptr, info.column_ids, "constant", nullptr, decision);
+		return nullptr;
+	}
+
 	auto filtered_list = PushdownInternal(context, filter_set);
 
-	ReportFilterPushdown(context, *filtered_list, info.column_ids, "constant", info);
+	ReportFilterPushdown(context, *filtered_list, info.column_ids, "constant", info, decision);
 
 	return std::move(filtered_list);
 }
 
-void DeltaMultiFileList::ReportFilterPushdown(ClientContext &context, DeltaMultiFileList &new_list,
+vector<pair<string, reference<TableFilter>>>
+DeltaMultiFileList::GetPartitionFilters(const TableFilterSet &filters) const {
+	vector<pair<string, reference<TableFilter>>> partition_filters;
+	for (auto &entry : filters.filters) {
+		if (entry.first >= names.size()) {
+			continue;
+		}
+		auto &name = names[entry.first];
+		if (std::find(partitions.begin(), partitions.end(), name) != partitions.end()) {
+			partition_filters.emplace_back(name, *entry.second);
+		}
+	}
+	return partition_filters;
+}
+
+//! A file is pruned if the constant value of its partition can not pass one of the filters
+static bool PrunedByPartitionFilters(const DeltaFileMetaData &file_metadata,
+                                     const vector<pair<string, reference<TableFilter>>> &partition_filters) {
+	for (auto &partition_filter : partition_filters) {
+		auto value = file_metadata.partition_map.find(partition_filter.first);
+		if (value == file_metadata.partition_map.end()) {
+			continue;
+		}
+		auto stats = BaseStatistics::FromConstant(value->second);
+		if (partition_filter.second.get().CheckStatistics(stats) == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DeltaMultiFileList::EstimatePrunedFiles(const TableFilterSet &filters, double &pruned_fraction) const {
+	unique_lock<mutex> lck(lock);
+	if (metadata.empty()) {
+		return false;
+	}
+
+	auto partition_filters = GetPartitionFilters(filters);
+	if (partition_filters.empty()) {
+		return false;
+	}
+
+	idx_t pruned_files = 0;
+	for (auto &file_metadata : metadata) {
+		if (PrunedByPartitionFilters(*file_metadata, partition_filters)) {
+			pruned_files++;
+		}
+	}
+	pruned_fraction = static_cast<double>(pruned_files) / static_cast<double>(metadata.size());
+	return true;
+}
+
+bool DeltaMultiFileList::AdaptivePushdown(ClientContext &context, const TableFilterSet &filters,
+                                          string &decision) const {
+	// Filters pushed into a list that was not listed yet apply to its first listing, so they come for free
+	{
+		unique_lock<mutex> lck(lock);
+		if (!initialized_scan) {
+			decision = "adaptive: pushed, files not listed yet";
+			return true;
+		}
+	}
+
+	// Otherwise pushing down lists the files again, which is only worth it if enough files are pruned. Column stats
+	// are not exposed by the kernel, so only filters on partition columns can be estimated. The cost of listing again
+	// is not modelled: it grows with the size of the log rather than the number of pruned files, so the decision only
+	// compares the pruned fraction against the threshold
+	double pruned_fraction;
+	if (!EstimatePrunedFiles(filters, pruned_fraction)) {
+		decision = "adaptive: skipped, no estimate";
+		return false;
+	}
+
+	double threshold = 0.2;
+	Value result;
+	if (context.TryGetCurrentSetting(ADAPTIVE_PUSHDOWN_THRESHOLD_SETTING, result) && !result.IsNull()) {
+		threshold = result.GetValue<double>();
+	}
+	auto pushed = pruned_fraction > 0 && pruned_fraction >= threshold;
+	decision = StringUtil::Format("adaptive: %s, estimated %d%% of files pruned", pushed ? "pushed" : "skipped",
+	                              static_cast<int64_t>(pruned_fraction * 100));
+	return pushed;
+}
+
+void DeltaMultiFileList::ReportFilterPushdown(ClientContext &context, optional_ptr<DeltaMultiFileList> new_list,
                                               const vector<column_t> &column_ids, const char *pushdown_type,
-                                              optional_ptr<MultiFilePushdownInfo> mfr_info) const {
+                                              optional_ptr<MultiFilePushdownInfo> mfr_info,
+                                              const string &decision) const {
 	auto &logger = Logger::Get(context);
 	auto log_level = LogLevel::LOG_INFO;
 	auto delta_log_type = "delta.FilterPushdown";
@@ -844,7 +1008,7 @@ void DeltaMultiFileList::ReportFilterPushdown(ClientContext &context, DeltaMulti
 			EnsureScanInitialized();
 			old_total = GetTotalFileCountInternal();
 		}
-		new_total = new_list.GetTotalFileCount();
+		new_total = new_list ? new_list->GetTotalFileCount() : old_total;
 
 		if (should_report_explain_output) {
 			if (!mfr_info->extra_info.total_files.IsValid()) {
@@ -878,7 +1042,8 @@ void DeltaMultiFileList::ReportFilterPushdown(ClientContext &context, DeltaMulti
 
 	// Report the new filters
 	vector<Value> filters_value_list;
-	for (auto &f : new_list.table_filters.filters) {
+	auto &filters_after = new_list ? new_list->table_filters : table_filters;
+	for (auto &f : filters_after.filters) {
 		auto &column_index = f.first;
 		auto &filter = f.second;
 		if (column_index < names.size()) {
@@ -902,6 +1067,7 @@ void DeltaMultiFileList::ReportFilterPushdown(ClientContext &context, DeltaMulti
 		struct_fields.push_back({"type", Value(pushdown_type)});
 		struct_fields.push_back({"filters_before", old_filters_value});
 		struct_fields.push_back({"filters_after", filters_value});
+		struct_fields.push_back({"decision", Value(decision)});
 		if (new_total != DConstants::INVALID_INDEX) {
 			struct_fields.push_back({"files_before", Value::BIGINT(old_total)});
 			struct_fields.push_back({"files_after", Value::BIGINT(new_total)});
@@ -937,8 +1103,13 @@ DeltaMultiFileList::DynamicFilterPushdown(ClientContext &context, const MultiFil
 	}
 
 	if (!filters_copy.filters.empty()) {
+		string decision = "pushed";
+		if (pushdown_mode == DeltaFilterPushdownMode::ADAPTIVE && !AdaptivePushdown(context, filters_copy, decision)) {
+			ReportFilterPushdown(context, nullptr, column_ids, "dynamic", nullptr, decision);
+			return nullptr;
+		}
 		auto new_snap = PushdownInternal(context, filters_copy);
-		ReportFilterPushdown(context, *new_snap, column_ids, "dynamic", nullptr);
+		ReportFilterPushdown(context, *new_snap, column_ids, "dynamic", nullptr, decision);
 		return std::move(new_snap);
 	}
 
@@ -979,20 +1150,59 @@ unique_ptr<NodeStatistics> DeltaMultiFileList::GetCardinality(ClientContext &con
 		return make_uniq<NodeStatistics>(0, 0);
 	}
 
+	// The kernel only prunes files on the filters it can translate to a predicate (e.g. not on IN filters): files of
+	// which the partition values do not pass the remaining filters are skipped by the scan, and not estimated
+	auto partition_filters = GetPartitionFilters(table_filters);
+
+	// Rows deleted by deletion vectors are known exactly, the kernel statistics do not reflect them
 	idx_t total_tuple_count = 0;
-	bool have_any_stats = false;
+	idx_t max_tuple_count = 0;
+	idx_t rows_with_stats = 0;
+	idx_t files_with_stats = 0;
+	idx_t bytes_with_stats = 0;
 	for (auto &metadatum : metadata) {
-		if (metadatum->cardinality != DConstants::INVALID_INDEX) {
-			have_any_stats = true;
-			total_tuple_count += metadatum->cardinality;
+		if (metadatum->cardinality == DConstants::INVALID_INDEX) {
+			continue;
+		}
+		rows_with_stats += metadatum->cardinality;
+		files_with_stats++;
+		if (metadatum->file_size != DConstants::INVALID_INDEX) {
+			bytes_with_stats += metadatum->file_size;
 		}
+		if (PrunedByPartitionFilters(*metadatum, partition_filters)) {
+			continue;
+		}
+		auto deleted_count = metadatum->deletion_vector ? metadatum->deletion_vector->DeletedCount() : 0;
+		total_tuple_count += metadatum->cardinality - MinValue<idx_t>(deleted_count, metadatum->cardinality);
+		max_tuple_count += metadatum->cardinality;
 	}
 
-	if (have_any_stats) {
-		return make_uniq<NodeStatistics>(total_tuple_count, total_tuple_count);
+	if (files_with_stats == 0) {
+		return nullptr;
 	}
 
-	return nullptr;
+	// Files without statistics are estimated from the rows per byte of the files with statistics, or the average
+	// number of rows per file if their size is unknown
+	if (files_with_stats < metadata.size()) {
+		auto rows_per_byte = bytes_with_stats > 0 ? static_cast<double>(rows_with_stats) / bytes_with_stats : 0;
+		auto rows_per_file = static_cast<double>(rows_with_stats) / files_with_stats;
+		for (auto &metadatum : metadata) {
+			if (metadatum->cardinality != DConstants::INVALID_INDEX ||
+			    PrunedByPartitionFilters(*metadatum, partition_filters)) {
+				continue;
+			}
+			double estimate = rows_per_file;
+			if (rows_per_byte > 0 && metadatum->file_size != DConstants::INVALID_INDEX) {
+				estimate = rows_per_byte * static_cast<double>(metadatum->file_size);
+			}
+			auto estimated_rows = static_cast<idx_t>(estimate);
+			auto deleted_count = metadatum->deletion_vector ? metadatum->deletion_vector->DeletedCount() : 0;
+			total_tuple_count += estimated_rows - MinValue<idx_t>(deleted_count, estimated_rows);
+			max_tuple_count += MaxValue<idx_t>(estimated_rows, deleted_count);
+		}
+	}
+
+	return make_uniq<NodeStatistics>(total_tuple_count, max_tuple_count);
 }
 
 idx_t DeltaMultiFileList::GetVersion() {
@@ -1001,6 +1211,11 @@ idx_t DeltaMultiFileList::GetVersion() {
 	return version;
 }
 
+bool DeltaMultiFileList::IsFiltered() const {
+	unique_lock<mutex> lck(lock);
+	return !table_filters.filters.empty() || file_selection;
+}
+
 DeltaFileMetaData &DeltaMultiFileList::GetMetaData(idx_t index) const {
 	unique_lock<mutex> lck(lock);
 	if (index >= metadata.size()) {
@@ -1009,16 +1224,106 @@ DeltaFileMetaData &DeltaMultiFileList::GetMetaData(idx_t index) const {
 	return *metadata[index];
 }
 
+idx_t DeltaMultiFileList::GetListedBytes(bool &listing_finished) const {
+	unique_lock<mutex> lck(lock);
+	listing_finished = files_exhausted;
+	idx_t result = 0;
+	for (auto &file_metadata : metadata) {
+		if (file_metadata->file_size != DConstants::INVALID_INDEX) {
+			result += file_metadata->file_size;
+		}
+	}
+	return result;
+}
+
+idx_t DeltaMultiFileList::GetMemoryUsage() const {
+	unique_lock<mutex> lck(lock);
+	idx_t result = metadata_reservation ? metadata_reservation->GetSize() : 0;
+	if (deletion_vector_cache) {
+		result += deletion_vector_cache->GetMemoryUsage();
+	}
+	return result;
+}
+
+OpenFileInfo DeltaMultiFileList::GetListedFileWithSize(idx_t i, idx_t &file_size, bool &listing_finished) const {
+	unique_lock<mutex> lck(lock);
+	listing_finished = files_exhausted;
+	if (i >= resolved_files.size()) {
+		file_size = DConstants::INVALID_INDEX;
+		return OpenFileInfo();
+	}
+	file_size = metadata[i]->file_size;
+	return resolved_files[i];
+}
+
+unordered_map<string, hash_t> DeltaMultiFileList::GetFileSignatures() {
+	unique_lock<mutex> lck(lock);
+	GetTotalFileCountInternal();
+
+	unordered_map<string, hash_t> result;
+	for (idx_t i = 0; i < resolved_files.size(); i++) {
+		auto &deletion_vector = metadata[i]->deletion_vector;
+		if (!deletion_vector || deletion_vector->DeletedCount() == 0) {
+			result[resolved_files[i].path] = 0;
+			continue;
+		}
+		result[resolved_files[i].path] =
+		    CombineHash(Hash<uint64_t>(deletion_vector->DeletedCount()), deletion_vector->DeletedRowsHash());
+	}
+	return result;
+}
+
 vector<string> DeltaMultiFileList::GetPartitionColumns() {
 	unique_lock<mutex> lck(lock);
 	EnsureScanInitialized();
 	return partitions;
 }
 
-vector<MultiFileColumnDefinition> &DeltaMultiFileList::GetLazyLoadedGlobalColumns() const {
+vector<MultiFileColumnDefinition> DeltaMultiFileList::GetGlobalColumns(const vector<ColumnIndex> &column_ids) const {
+	unique_lock<mutex> lck(lock);
+	EnsureScanInitialized();
+
+	unordered_set<idx_t> projected_columns;
+	for (auto &column_id : column_ids) {
+		projected_columns.insert(column_id.GetPrimaryIndex());
+	}
+
+	// Only the projected columns need their identifiers, default expressions and nested children: for wide tables
+	// this is much cheaper than constructing the definitions for the full schema
+	vector<MultiFileColumnDefinition> result;
+	result.reserve(names.size());
+	for (idx_t i = 0; i < names.size(); i++) {
+		if (projected_columns.find(i) == projected_columns.end()) {
+			result.emplace_back(names[i], types[i]);
+			continue;
+		}
+
+		auto column_defs = MultiFileColumnDefinition::ColumnsFromNamesAndTypes({names[i]}, {types[i]});
+		auto &field_id = physical_schema->field_ids[i];
+		if (physical_schema->map_by_field_id && !field_id.id.IsNull()) {
+			auto &col = column_defs[0];
+			col.default_expression = make_uniq<ConstantExpression>(Value(col.type));
+			col.identifier = field_id.id;
+			InjectFieldIds(field_id.children, col);
+		} else {
+			InjectColumnIdentifiers({names[i]}, {types[i]}, {physical_schema->names[i]}, {physical_schema->types[i]},
+			                        column_defs);
+		}
+		result.push_back(column_defs[0]);
+	}
+	return result;
+}
+
+const vector<string> &DeltaMultiFileList::GetPhysicalColumnNames() const {
+	unique_lock<mutex> lck(lock);
+	EnsureScanInitialized();
+	return physical_schema->names;
+}
+
+bool DeltaMultiFileList::MapByFieldId() const {
 	unique_lock<mutex> lck(lock);
 	EnsureScanInitialized();
-	return lazy_loaded_schema;
+	return physical_schema->map_by_field_id;
 }
 
 unique_ptr<MultiFileReader> DeltaMultiFileReader::CreateInstance(const TableFunction &table_function) {
@@ -6,6 +6,7 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/logging/logger.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/extension_helper.hpp"
 #include "duckdb/main/extension_util.hpp"
@@ -15,37 +16,38 @@
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/parser/parsed_expression.hpp"
+#include "duckdb/parser/expression/columnref_expression.hpp"
 #include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression_binder.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 
 namespace duckdb {
 
+//! The log type of transforms that fall back to the regular column mapping
+static constexpr const char *DELTA_TRANSFORM_LOG_TYPE = "delta.Transform";
+//! The log type of files of which filters were removed or that were skipped based on their statistics
+static constexpr const char *DELTA_FILTER_ELIMINATION_LOG_TYPE = "delta.FilterElimination";
+static constexpr const char *PROGRESS_LOG_TYPE = "delta.ScanProgress";
+
 constexpr column_t DeltaMultiFileReader::DELTA_FILE_NUMBER_COLUMN_ID;
 
 struct DeltaDeleteFilter : public DeleteFilter {
 public:
-	DeltaDeleteFilter(const ffi::KernelBoolSlice &dv) : dv(dv) {
+	explicit DeltaDeleteFilter(shared_ptr<const DeltaDeletionVector> dv_p) : dv(std::move(dv_p)) {
 	}
 
 public:
 	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) override {
-		if (count == 0) {
-			return 0;
-		}
-		result_sel.Initialize(STANDARD_VECTOR_SIZE);
-		idx_t current_select = 0;
-		for (idx_t i = 0; i < count; i++) {
-			auto row_id = i + start_row_index;
-
-			const bool is_selected = row_id >= dv.len || dv.ptr[row_id];
-			result_sel.set_index(current_select, i);
-			current_select += is_selected;
-		}
-		return current_select;
+		return dv->Filter(start_row_index, count, result_sel);
 	}
 
 public:
-	const ffi::KernelBoolSlice &dv;
+	shared_ptr<const DeltaDeletionVector> dv;
 };
 
 void FinalizeBindBaseOverride(MultiFileReaderData &reader_data, const MultiFileOptions &file_options,
@@ -157,6 +159,492 @@ void DeltaMultiFileReader::BindOptions(MultiFileOptions &options, MultiFileList
 	}
 }
 
+const vector<MultiFileColumnDefinition> &
+DeltaMultiFileReaderGlobalState::GetGlobalColumns(const DeltaMultiFileList &snapshot,
+                                                  const vector<MultiFileColumnDefinition> &global_columns,
+                                                  const vector<ColumnIndex> &global_column_ids) {
+	lock_guard<mutex> guard(lock);
+	if (initialized_global_columns) {
+		return scan_global_columns;
+	}
+
+	scan_global_columns = snapshot.GetGlobalColumns(global_column_ids);
+	for (idx_t i = scan_global_columns.size(); i < global_columns.size(); i++) {
+		scan_global_columns.push_back(global_columns[i]);
+	}
+	initialized_global_columns = true;
+	return scan_global_columns;
+}
+
+const MultiFileReaderBindData &
+DeltaMultiFileReaderGlobalState::GetReaderBindData(const DeltaMultiFileList &snapshot,
+                                                   const MultiFileReaderBindData &bind_data) {
+	if (!snapshot.MapByFieldId()) {
+		return bind_data;
+	}
+	lock_guard<mutex> guard(lock);
+	if (!field_id_bind_data) {
+		field_id_bind_data = make_uniq<MultiFileReaderBindData>(bind_data);
+		field_id_bind_data->mapping = MultiFileColumnMappingMode::BY_FIELD_ID;
+	}
+	return *field_id_bind_data;
+}
+
+//! Replace all expressions of the given class, returns false if the callback fails for any of them
+static bool ReplaceExpressions(unique_ptr<Expression> &expr, ExpressionClass expression_class,
+                               const std::function<bool(unique_ptr<Expression> &)> &callback) {
+	if (expr->GetExpressionClass() == expression_class) {
+		return callback(expr);
+	}
+	bool success = true;
+	ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> &child) {
+		success = success && ReplaceExpressions(child, expression_class, callback);
+	});
+	return success;
+}
+
+//! Transforms that can not be bound are not applied, which changes the result if the column mapping does not cover them
+static void LogTransformFallback(ClientContext &context, const string &transform, const Exception &ex) {
+	auto &logger = Logger::Get(context);
+	if (!logger.ShouldLog(DELTA_TRANSFORM_LOG_TYPE, LogLevel::LOG_WARN)) {
+		return;
+	}
+	ErrorData error(ex);
+	logger.WriteLog(DELTA_TRANSFORM_LOG_TYPE, LogLevel::LOG_WARN,
+	                StringUtil::Format("Failed to bind transform '%s', falling back to the column mapping: %s",
+	                                   transform, error.RawMessage()));
+}
+
+unique_ptr<Expression>
+DeltaMultiFileReaderGlobalState::BindTransformExpression(ClientContext &context, const vector<string> &physical_names,
+                                                         const vector<LogicalType> &physical_types,
+                                                         const ParsedExpression &transform) {
+	auto transform_string = transform.ToString();
+	// The same transform binds differently for files written with different physical types
+	auto key = transform_string;
+	for (auto &type : physical_types) {
+		key += "|" + type.ToString();
+	}
+
+	lock_guard<mutex> guard(lock);
+	auto entry = transform_expressions.find(key);
+	if (entry == transform_expressions.end()) {
+		unique_ptr<Expression> bound_transform;
+		try {
+			auto binder = Binder::CreateBinder(context);
+			binder->bind_context.AddGenericBinding(0, "delta_transform", physical_names, physical_types);
+			ExpressionBinder expression_binder(*binder, context);
+			auto parsed_transform = transform.Copy();
+			bound_transform = expression_binder.Bind(parsed_transform);
+			ReplaceExpressions(bound_transform, ExpressionClass::BOUND_COLUMN_REF, [](unique_ptr<Expression> &expr) {
+				auto &column_ref = expr->Cast<BoundColumnRefExpression>();
+				expr = make_uniq<BoundReferenceExpression>(column_ref.return_type, column_ref.binding.column_index);
+				return true;
+			});
+		} catch (BinderException &ex) {
+			// Transforms referencing columns or types we can not bind are left to the regular column mapping
+			LogTransformFallback(context, transform_string, ex);
+			bound_transform = nullptr;
+		} catch (CatalogException &ex) {
+			// Transforms using functions DuckDB does not have are left to the regular column mapping
+			LogTransformFallback(context, transform_string, ex);
+			bound_transform = nullptr;
+		}
+		entry = transform_expressions.emplace(key, std::move(bound_transform)).first;
+	}
+	return entry->second ? entry->second->Copy() : nullptr;
+}
+
+shared_ptr<DeltaSchemaMapping> DeltaMultiFileReaderGlobalState::GetSchemaMapping(const string &fingerprint) {
+	lock_guard<mutex> guard(lock);
+	auto entry = schema_mappings.find(fingerprint);
+	if (entry == schema_mappings.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+void DeltaMultiFileReaderGlobalState::AddSchemaMapping(const string &fingerprint,
+                                                       shared_ptr<DeltaSchemaMapping> mapping) {
+	lock_guard<mutex> guard(lock);
+	schema_mappings.emplace(fingerprint, std::move(mapping));
+}
+
+void DeltaMultiFileReaderGlobalState::FileStarted(const shared_ptr<BaseFileReader> &reader, idx_t file_size) {
+	if (file_size == DConstants::INVALID_INDEX) {
+		return;
+	}
+	lock_guard<mutex> guard(progress_lock);
+	open_files.emplace_back(reader, file_size);
+}
+
+double DeltaMultiFileReaderGlobalState::GetProgress(ClientContext &context) const {
+	auto &snapshot = file_list->Cast<DeltaMultiFileList>();
+
+	lock_guard<mutex> guard(progress_lock);
+	double read_bytes = 0;
+	for (idx_t i = 0; i < open_files.size();) {
+		auto reader = open_files[i].first.lock();
+		if (!reader) {
+			completed_bytes += open_files[i].second;
+			open_files[i] = std::move(open_files.back());
+			open_files.pop_back();
+			continue;
+		}
+		read_bytes += static_cast<double>(open_files[i].second) * reader->GetProgressInFile(context) / 100.0;
+		i++;
+	}
+	read_bytes += static_cast<double>(completed_bytes);
+
+	double listed_bytes;
+	double progress;
+	if (total_bytes.IsValid()) {
+		listed_bytes = static_cast<double>(total_bytes.GetIndex());
+		progress = listed_bytes == 0 ? 100 : MinValue<double>(100.0 * read_bytes / listed_bytes, 100);
+	} else {
+		bool listing_finished;
+		auto bytes = snapshot.GetListedBytes(listing_finished);
+		if (listing_finished) {
+			total_bytes = bytes;
+		}
+		// While the files are still being listed, the files that are not listed yet are assumed to be as large as
+		// the ones listed so far. This is only an approximation, so the scan is not reported as done before the
+		// listing finished
+		listed_bytes = static_cast<double>(bytes) * (listing_finished ? 1 : 2);
+		if (listed_bytes == 0) {
+			progress = listing_finished ? 100 : 0;
+		} else {
+			progress = MinValue<double>(100.0 * read_bytes / listed_bytes, listing_finished ? 100 : 99);
+		}
+	}
+
+	// The estimated total changes once the listing finishes, which must not make the reported progress go back
+	progress = MaxValue(progress, reported_progress);
+	auto changed = progress_polls == 0 || progress != reported_progress;
+	reported_progress = progress;
+	progress_polls++;
+
+	// The progress is polled continuously while the query runs, only changes are logged
+	auto &logger = Logger::Get(context);
+	if (changed && logger.ShouldLog(PROGRESS_LOG_TYPE, LogLevel::LOG_DEBUG)) {
+		child_list_t<Value> struct_fields;
+		struct_fields.push_back({"poll", Value::BIGINT(NumericCast<int64_t>(progress_polls))});
+		struct_fields.push_back({"progress", Value::DOUBLE(progress)});
+		struct_fields.push_back({"listing_finished", Value::BOOLEAN(total_bytes.IsValid())});
+		logger.WriteLog(PROGRESS_LOG_TYPE, LogLevel::LOG_DEBUG, Value::STRUCT(struct_fields).ToString());
+	}
+	return progress;
+}
+
+static void AppendColumnFingerprint(const MultiFileColumnDefinition &column, string &result) {
+	// Length-prefix the name so that arbitrary column names can not produce colliding fingerprints
+	result += to_string(column.name.size()) + ":" + column.name + ":" + column.type.ToString();
+	if (!column.identifier.IsNull()) {
+		result += "#" + column.identifier.ToString();
+	}
+	if (column.default_expression) {
+		result += "=" + column.default_expression->ToString();
+	}
+	if (!column.children.empty()) {
+		result += "{";
+		for (auto &child : column.children) {
+			AppendColumnFingerprint(child, result);
+		}
+		result += "}";
+	}
+	result += ";";
+}
+
+//! The fingerprint of a file consists of its physical schema and the set of global columns that are constant for it.
+//! Files with equal fingerprints produce the same column mapping, apart from the values of the constants
+static string GetSchemaMappingFingerprint(const MultiFileReaderData &reader_data) {
+	string result;
+	for (auto &column : reader_data.reader->GetColumns()) {
+		AppendColumnFingerprint(column, result);
+	}
+	result += "|";
+	for (auto &entry : reader_data.constant_map) {
+		result += to_string(entry.column_idx.index) + ",";
+	}
+	return result;
+}
+
+//! A mapping can only be reused if it does not depend on the values of the per-file constants or on per-file state
+//! such as virtual columns
+static bool CanCacheSchemaMapping(const MultiFileReaderData &reader_data, const vector<ColumnIndex> &global_column_ids,
+                                  optional_ptr<TableFilterSet> table_filters) {
+	unordered_set<idx_t> constant_columns;
+	for (auto &entry : reader_data.constant_map) {
+		constant_columns.insert(entry.column_idx.index);
+	}
+	for (idx_t i = 0; i < global_column_ids.size(); i++) {
+		if (IsVirtualColumn(global_column_ids[i].GetPrimaryIndex()) &&
+		    constant_columns.find(i) == constant_columns.end()) {
+			return false;
+		}
+	}
+	if (table_filters) {
+		// Filters on constants are evaluated against the constant value and may skip the file
+		for (auto &filter : table_filters->filters) {
+			if (constant_columns.find(filter.first) != constant_columns.end()) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static unique_ptr<TableFilterSet> CopyTableFilters(const unique_ptr<TableFilterSet> &filters) {
+	if (!filters) {
+		return nullptr;
+	}
+	auto result = make_uniq<TableFilterSet>();
+	for (auto &entry : filters->filters) {
+		result->PushFilter(ColumnIndex(entry.first), entry.second->Copy());
+	}
+	return result;
+}
+
+//! Collect the positions (child indexes from the root) of the constants holding the value of a per-file constant
+static void FindConstantPaths(Expression &expr, const Value &value, vector<idx_t> &path,
+                              vector<vector<idx_t>> &result) {
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+		auto &constant = expr.Cast<BoundConstantExpression>();
+		if (constant.value.type() == value.type() && Value::NotDistinctFrom(constant.value, value)) {
+			result.push_back(path);
+		}
+		return;
+	}
+	idx_t child_idx = 0;
+	ExpressionIterator::EnumerateChildren(expr, [&](Expression &child) {
+		path.push_back(child_idx++);
+		FindConstantPaths(child, value, path, result);
+		path.pop_back();
+	});
+}
+
+static optional_ptr<Expression> GetExpressionAtPath(Expression &expr, const vector<idx_t> &path, idx_t depth = 0) {
+	if (depth == path.size()) {
+		return &expr;
+	}
+	optional_ptr<Expression> result;
+	idx_t child_idx = 0;
+	ExpressionIterator::EnumerateChildren(expr, [&](Expression &child) {
+		if (child_idx++ == path[depth]) {
+			result = GetExpressionAtPath(child, path, depth + 1);
+		}
+	});
+	return result;
+}
+
+//! Returns nullptr if the mapping can not be reused: the constant of a column can not be told apart from other
+//! constants with the same value in its expression
+static shared_ptr<DeltaSchemaMapping> CreateSchemaMapping(const MultiFileReaderData &reader_data) {
+	auto &reader = *reader_data.reader;
+	auto result = make_shared_ptr<DeltaSchemaMapping>();
+	for (auto &entry : reader_data.constant_map) {
+		auto column_idx = entry.column_idx.index;
+		if (column_idx >= reader_data.expressions.size() || !reader_data.expressions[column_idx]) {
+			return nullptr;
+		}
+		vector<idx_t> path;
+		vector<vector<idx_t>> paths;
+		FindConstantPaths(*reader_data.expressions[column_idx], entry.value, path, paths);
+		if (paths.size() != 1) {
+			return nullptr;
+		}
+		result->constant_paths.emplace(column_idx, std::move(paths[0]));
+	}
+	result->column_ids = reader.column_ids;
+	result->column_indexes = reader.column_indexes;
+	for (auto &entry : reader.expression_map) {
+		result->expression_map.emplace(entry.first, entry.second->Copy());
+	}
+	result->filters = CopyTableFilters(reader.filters);
+	for (auto &expr : reader_data.expressions) {
+		result->expressions.push_back(expr ? expr->Copy() : nullptr);
+	}
+	return result;
+}
+
+//! Apply a cached mapping to the reader, substituting the constants of this file. Returns false if the cached
+//! expressions do not have the expected shape, in which case the mapping has to be created from scratch
+static bool ApplySchemaMapping(MultiFileReaderData &reader_data, const DeltaSchemaMapping &mapping) {
+	vector<unique_ptr<Expression>> expressions;
+	for (auto &expr : mapping.expressions) {
+		expressions.push_back(expr ? expr->Copy() : nullptr);
+	}
+	for (auto &entry : reader_data.constant_map) {
+		auto column_idx = entry.column_idx.index;
+		auto path = mapping.constant_paths.find(column_idx);
+		if (column_idx >= expressions.size() || !expressions[column_idx] || path == mapping.constant_paths.end()) {
+			return false;
+		}
+		auto constant = GetExpressionAtPath(*expressions[column_idx], path->second);
+		if (!constant || constant->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &constant_expr = constant->Cast<BoundConstantExpression>();
+		constant_expr.value = entry.value.DefaultCastAs(constant_expr.return_type);
+	}
+
+	auto &reader = *reader_data.reader;
+	reader.column_ids = mapping.column_ids;
+	reader.column_indexes = mapping.column_indexes;
+	reader.expression_map.clear();
+	for (auto &entry : mapping.expression_map) {
+		reader.expression_map.emplace(entry.first, entry.second->Copy());
+	}
+	reader.filters = CopyTableFilters(mapping.filters);
+	reader_data.expressions = std::move(expressions);
+	return true;
+}
+
+//! Replace the mapped expressions of the columns for which the kernel provides a non-trivial transform (e.g. type
+//! widening) by the bound transform. These are then evaluated vectorized by the regular FinalizeChunk
+static void ApplyTransformExpressions(ClientContext &context, MultiFileReaderData &reader_data,
+                                      const DeltaMultiFileList &snapshot,
+                                      const vector<MultiFileColumnDefinition> &global_columns,
+                                      const vector<ColumnIndex> &global_column_ids,
+                                      DeltaMultiFileReaderGlobalState &global_state) {
+	auto &file_metadata = snapshot.GetMetaData(reader_data.reader->file_list_idx.GetIndex());
+	if (!file_metadata.transform_expression) {
+		return;
+	}
+	auto &column_expressions = KernelUtils::UnpackTopLevelStruct(*file_metadata.transform_expression);
+	auto &physical_names = snapshot.GetPhysicalColumnNames();
+
+	unordered_map<idx_t, idx_t> projected_columns;
+	for (idx_t i = 0; i < global_column_ids.size(); i++) {
+		projected_columns[global_column_ids[i].GetPrimaryIndex()] = i;
+	}
+
+	// Bind against the types the columns have in this file: for files written before a type widening these differ
+	// from the global types, and the transform casts them
+	case_insensitive_map_t<LogicalType> file_types;
+	for (auto &column : reader_data.reader->GetColumns()) {
+		file_types.emplace(column.name, column.type);
+	}
+	vector<LogicalType> physical_types;
+	for (idx_t i = 0; i < physical_names.size(); i++) {
+		auto file_type = file_types.find(physical_names[i]);
+		physical_types.push_back(file_type != file_types.end() ? file_type->second : global_columns[i].type);
+	}
+
+	vector<pair<idx_t, unique_ptr<Expression>>> transformed_columns;
+	for (idx_t i = 0; i < global_column_ids.size(); i++) {
+		auto col_id = global_column_ids[i].GetPrimaryIndex();
+		if (IsVirtualColumn(col_id) || col_id >= column_expressions.size() || col_id >= physical_names.size()) {
+			continue;
+		}
+		auto &column_expression = column_expressions[col_id];
+		// Constants have already been added to the constant map in FinalizeBind
+		if (!column_expression || column_expression->type == ExpressionType::VALUE_CONSTANT) {
+			continue;
+		}
+		// Plain references to the physical column are handled by the column mapping
+		if (column_expression->type == ExpressionType::COLUMN_REF &&
+		    column_expression->Cast<ColumnRefExpression>().GetColumnName() == physical_names[col_id]) {
+			continue;
+		}
+
+		auto expr = global_state.BindTransformExpression(context, physical_names, physical_types, *column_expression);
+		if (!expr) {
+			continue;
+		}
+		bool success = ReplaceExpressions(expr, ExpressionClass::BOUND_REF, [&](unique_ptr<Expression> &ref) {
+			auto entry = projected_columns.find(ref->Cast<BoundReferenceExpression>().index);
+			if (entry == projected_columns.end() || entry->second >= reader_data.expressions.size() ||
+			    !reader_data.expressions[entry->second]) {
+				return false;
+			}
+			auto mapped = reader_data.expressions[entry->second]->Copy();
+			// The column mapping casts the physical column to the global type, the transform takes over that cast
+			if (mapped->GetExpressionClass() == ExpressionClass::BOUND_CAST) {
+				auto &cast = mapped->Cast<BoundCastExpression>();
+				if (cast.child->GetExpressionClass() == ExpressionClass::BOUND_REF) {
+					mapped = std::move(cast.child);
+				}
+			}
+			if (mapped->return_type != ref->return_type) {
+				mapped = BoundCastExpression::AddCastToType(context, std::move(mapped), ref->return_type);
+			}
+			ref = std::move(mapped);
+			return true;
+		});
+		if (!success) {
+			continue;
+		}
+		auto &global_type = global_columns[col_id].type;
+		if (expr->return_type != global_type) {
+			expr = BoundCastExpression::AddCastToType(context, std::move(expr), global_type);
+		}
+		transformed_columns.emplace_back(i, std::move(expr));
+	}
+
+	for (auto &transformed_column : transformed_columns) {
+		reader_data.expressions[transformed_column.first] = std::move(transformed_column.second);
+	}
+}
+
+static void LogFilterElimination(ClientContext &context, BaseFileReader &reader, idx_t filters_removed, bool skipped) {
+	auto &logger = Logger::Get(context);
+	if (!logger.ShouldLog(DELTA_FILTER_ELIMINATION_LOG_TYPE, LogLevel::LOG_INFO)) {
+		return;
+	}
+	child_list_t<Value> struct_fields;
+	struct_fields.push_back({"path", Value(reader.GetFileName())});
+	struct_fields.push_back({"filters_removed", Value::BIGINT(NumericCast<int64_t>(filters_removed))});
+	struct_fields.push_back({"skipped", Value::BOOLEAN(skipped)});
+	logger.WriteLog(DELTA_FILTER_ELIMINATION_LOG_TYPE, LogLevel::LOG_INFO, Value::STRUCT(struct_fields).ToString());
+}
+
+//! Check the filters pushed into the reader against the statistics of the file: filters that hold for every row are
+//! removed so they are not evaluated row by row, files for which a filter can not hold for any row are skipped
+static ReaderInitializeType EliminateFiltersWithStatistics(ClientContext &context, MultiFileReaderData &reader_data) {
+	auto &reader = *reader_data.reader;
+	if (!reader.filters || reader.filters->filters.empty()) {
+		return ReaderInitializeType::INITIALIZED;
+	}
+
+	vector<idx_t> always_true_filters;
+	for (auto &entry : reader.filters->filters) {
+		auto column_idx = entry.first;
+		// Filters on columns that are cast or transformed are evaluated against the converted value: leave them be
+		if (column_idx >= reader.column_indexes.size() ||
+		    reader.expression_map.find(column_idx) != reader.expression_map.end()) {
+			continue;
+		}
+		auto local_idx = reader.column_indexes[column_idx].GetPrimaryIndex();
+		if (local_idx >= reader.columns.size()) {
+			continue;
+		}
+		auto stats = reader.GetStatistics(context, reader.columns[local_idx].name);
+		if (!stats) {
+			continue;
+		}
+		switch (entry.second->CheckStatistics(*stats)) {
+		case FilterPropagateResult::FILTER_ALWAYS_FALSE:
+		case FilterPropagateResult::FILTER_FALSE_OR_NULL:
+			LogFilterElimination(context, reader, 0, true);
+			return ReaderInitializeType::SKIP_READING_FILE;
+		case FilterPropagateResult::FILTER_ALWAYS_TRUE:
+			always_true_filters.push_back(column_idx);
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (auto &column_idx : always_true_filters) {
+		reader.filters->filters.erase(column_idx);
+	}
+	if (!always_true_filters.empty()) {
+		LogFilterElimination(context, reader, always_true_filters.size(), false);
+	}
+	return ReaderInitializeType::INITIALIZED;
+}
+
 ReaderInitializeType DeltaMultiFileReader::InitializeReader(MultiFileReaderData &reader_data,
                                                             const MultiFileBindData &bind_data,
                                                             const vector<MultiFileColumnDefinition> &global_columns,
@@ -168,23 +656,51 @@ ReaderInitializeType DeltaMultiFileReader::InitializeReader(MultiFileReaderData
 	auto &delta_global_state = global_state->Cast<DeltaMultiFileReaderGlobalState>();
 	auto &snapshot = delta_global_state.file_list->Cast<DeltaMultiFileList>();
 
-	vector<MultiFileColumnDefinition> *global_columns_to_use;
-	auto &scan_columns = snapshot.GetLazyLoadedGlobalColumns();
-	vector<MultiFileColumnDefinition> column_copy;
-	if (scan_columns.size() != global_columns.size()) {
-		column_copy = scan_columns;
-		for (idx_t i = scan_columns.size(); i < global_columns.size(); i++) {
-			column_copy.push_back(global_columns[i]);
-		}
-		global_columns_to_use = &column_copy;
-	} else {
-		global_columns_to_use = &scan_columns;
+	auto &global_columns_to_use = delta_global_state.GetGlobalColumns(snapshot, global_columns, global_column_ids);
+	auto &reader_bind = delta_global_state.GetReaderBindData(snapshot, bind_data.reader_bind);
+
+	if (delta_global_state.read_ahead) {
+		delta_global_state.read_ahead->FileOpened(reader_data.reader->file_list_idx.GetIndex());
 	}
 
-	FinalizeBind(reader_data, bind_data.file_options, bind_data.reader_bind, *global_columns_to_use, global_column_ids,
+	// Files of which every row is deleted do not need to be read at all
+	auto &file_metadata = snapshot.GetMetaData(reader_data.reader->file_list_idx.GetIndex());
+	delta_global_state.FileStarted(reader_data.reader, file_metadata.file_size);
+	if (file_metadata.deletion_vector && file_metadata.cardinality != DConstants::INVALID_INDEX &&
+	    file_metadata.deletion_vector->AllRowsDeleted(file_metadata.cardinality)) {
+		return ReaderInitializeType::SKIP_READING_FILE;
+	}
+
+	FinalizeBind(reader_data, bind_data.file_options, bind_data.reader_bind, global_columns_to_use, global_column_ids,
 	             context, global_state);
-	return CreateMapping(context, reader_data, *global_columns_to_use, global_column_ids, table_filters,
-	                     gstate.file_list, bind_data.reader_bind, bind_data.virtual_columns);
+
+	// Tables typically only have a handful of distinct physical schemas: reuse the mapping of a previous file with the
+	// same schema instead of recomputing it for every file
+	string fingerprint;
+	if (CanCacheSchemaMapping(reader_data, global_column_ids, table_filters)) {
+		fingerprint = GetSchemaMappingFingerprint(reader_data);
+		auto cached_mapping = delta_global_state.GetSchemaMapping(fingerprint);
+		if (cached_mapping && ApplySchemaMapping(reader_data, *cached_mapping)) {
+			ApplyTransformExpressions(context, reader_data, snapshot, global_columns_to_use, global_column_ids,
+			                          delta_global_state);
+			return EliminateFiltersWithStatistics(context, reader_data);
+		}
+	}
+
+	auto result = CreateMapping(context, reader_data, global_columns_to_use, global_column_ids, table_filters,
+	                            gstate.file_list, reader_bind, bind_data.virtual_columns);
+	if (result != ReaderInitializeType::INITIALIZED) {
+		return result;
+	}
+	if (!fingerprint.empty()) {
+		auto mapping = CreateSchemaMapping(reader_data);
+		if (mapping) {
+			delta_global_state.AddSchemaMapping(fingerprint, std::move(mapping));
+		}
+	}
+	ApplyTransformExpressions(context, reader_data, snapshot, global_columns_to_use, global_column_ids,
+	                          delta_global_state);
+	return EliminateFiltersWithStatistics(context, reader_data);
 }
 
 void DeltaMultiFileReader::FinalizeBind(MultiFileReaderData &reader_data, const MultiFileOptions &file_options,
@@ -200,29 +716,30 @@ void DeltaMultiFileReader::FinalizeBind(MultiFileReaderData &reader_data, const
 	const auto &snapshot = dynamic_cast<const DeltaMultiFileList &>(*global_state->file_list);
 	auto &file_metadata = snapshot.GetMetaData(reader_data.reader->file_list_idx.GetIndex());
 
-	// TODO: inject these in the global column definitions instead?
-	if (!file_metadata.partition_map.empty()) {
+	// Literals in the kernel transform (e.g. partition values) are constant for the whole file
+	if (file_metadata.transform_expression) {
+		auto &column_expressions = KernelUtils::UnpackTopLevelStruct(*file_metadata.transform_expression);
 		for (idx_t i = 0; i < global_column_ids.size(); i++) {
 			auto global_idx = MultiFileGlobalIndex(i);
 			column_t col_id = global_column_ids[i].GetPrimaryIndex();
 
-			if (IsVirtualColumn(col_id)) {
+			if (IsVirtualColumn(col_id) || col_id >= column_expressions.size()) {
 				continue;
 			}
 
-			auto col_partition_entry = file_metadata.partition_map.find(global_columns[col_id].name);
-			if (col_partition_entry != file_metadata.partition_map.end()) {
+			auto &column_expression = column_expressions[col_id];
+			if (column_expression && column_expression->type == ExpressionType::VALUE_CONSTANT) {
 				auto &current_type = global_columns[col_id].type;
-				auto maybe_value = Value(col_partition_entry->second).DefaultCastAs(current_type);
+				auto maybe_value = column_expression->Cast<ConstantExpression>().value.DefaultCastAs(current_type);
 				reader_data.constant_map.Add(global_idx, maybe_value);
 			}
 		}
 	}
 
 	auto &reader = *reader_data.reader;
-	if (file_metadata.selection_vector.ptr) {
+	if (file_metadata.deletion_vector && file_metadata.deletion_vector->DeletedCount() > 0) {
 		//! Push the deletes into the parquet scan
-		reader.deletion_filter = make_uniq<DeltaDeleteFilter>(file_metadata.selection_vector);
+		reader.deletion_filter = make_uniq<DeltaDeleteFilter>(file_metadata.deletion_vector);
 	}
 }
 
@@ -240,6 +757,14 @@ shared_ptr<MultiFileList> DeltaMultiFileReader::CreateFileList(ClientContext &co
 		}
 	}
 
+	auto registry = context.registered_state->Get<DeltaSnapshotRegistry>(DeltaSnapshotRegistry::NAME);
+	if (registry) {
+		auto registered_snapshot = registry->Lookup(DeltaMultiFileList::ToDeltaPath(paths[0]));
+		if (registered_snapshot) {
+			return registered_snapshot;
+		}
+	}
+
 	return make_shared_ptr<DeltaMultiFileList>(context, paths[0]);
 }
 
@@ -266,6 +791,12 @@ DeltaMultiFileReader::InitializeGlobalState(ClientContext &context, const MultiF
 
 	auto res = make_uniq<DeltaMultiFileReaderGlobalState>(extra_columns, &file_list);
 
+	auto &delta_file_list = file_list.Cast<DeltaMultiFileList>();
+	idx_t read_ahead_window;
+	if (DeltaReadAhead::Enabled(context, delta_file_list.GetPath(), read_ahead_window)) {
+		res->read_ahead = make_uniq<DeltaReadAhead>(context, delta_file_list, read_ahead_window);
+	}
+
 	return std::move(res);
 }
 
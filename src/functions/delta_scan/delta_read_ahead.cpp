@@ -0,0 +1,369 @@
+#include "functions/delta_scan/delta_read_ahead.hpp"
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/caching_file_system.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+DeltaReadAheadPool::~DeltaReadAheadPool() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+		pending.clear();
+		hedge_candidates.clear();
+	}
+	cv.notify_all();
+	hedge_cv.notify_all();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (hedge_thread.joinable()) {
+		hedge_thread.join();
+	}
+}
+
+shared_ptr<DeltaReadAheadPool> DeltaReadAheadPool::Get(ClientContext &context) {
+	return ObjectCache::GetObjectCache(context).GetOrCreate<DeltaReadAheadPool>(ObjectType());
+}
+
+void DeltaReadAheadPool::Schedule(DeltaReadAhead &read_ahead) {
+	{
+		lock_guard<mutex> guard(lock);
+		pending.push_back(&read_ahead);
+		if (threads.size() < MinValue<idx_t>(pending.size(), MAX_THREADS)) {
+			threads.emplace_back([this]() { Worker(); });
+		}
+	}
+	cv.notify_one();
+}
+
+void DeltaReadAheadPool::ScheduleHedge(DeltaHedgeCandidate candidate) {
+	{
+		lock_guard<mutex> guard(lock);
+		if (!hedge_thread.joinable()) {
+			hedge_thread = std::thread([this]() { HedgeWorker(); });
+		}
+		hedge_candidates.push_back(std::move(candidate));
+	}
+	hedge_cv.notify_one();
+}
+
+void DeltaReadAheadPool::Remove(DeltaReadAhead &read_ahead) {
+	unique_lock<mutex> guard(lock);
+	pending.erase(std::remove(pending.begin(), pending.end(), &read_ahead), pending.end());
+	hedge_candidates.erase(std::remove_if(hedge_candidates.begin(), hedge_candidates.end(),
+	                                      [&](const DeltaHedgeCandidate &candidate) {
+		                                      return candidate.read_ahead == &read_ahead;
+	                                      }),
+	                       hedge_candidates.end());
+	// A hedged request that lost the race may still be running
+	finished_cv.wait(guard, [&]() { return running.find(&read_ahead) == running.end(); });
+}
+
+void DeltaReadAheadPool::WorkFinished(DeltaReadAhead &read_ahead) {
+	auto entry = running.find(&read_ahead);
+	if (--entry->second == 0) {
+		running.erase(entry);
+		finished_cv.notify_all();
+	}
+}
+
+void DeltaReadAheadPool::Worker() {
+	unique_lock<mutex> guard(lock);
+	while (!shutdown) {
+		if (pending.empty()) {
+			cv.wait(guard);
+			continue;
+		}
+		auto &read_ahead = *pending.front();
+		pending.pop_front();
+		running[&read_ahead]++;
+
+		guard.unlock();
+		read_ahead.RunPrefetch();
+		guard.lock();
+		WorkFinished(read_ahead);
+	}
+}
+
+void DeltaReadAheadPool::HedgeWorker() {
+	unique_lock<mutex> guard(lock);
+	while (!shutdown) {
+		if (hedge_candidates.empty()) {
+			hedge_cv.wait(guard);
+			continue;
+		}
+		auto next = std::min_element(
+		    hedge_candidates.begin(), hedge_candidates.end(),
+		    [](const DeltaHedgeCandidate &a, const DeltaHedgeCandidate &b) { return a.deadline < b.deadline; });
+		if (std::chrono::steady_clock::now() < next->deadline) {
+			hedge_cv.wait_until(guard, next->deadline);
+			continue;
+		}
+		auto candidate = std::move(*next);
+		hedge_candidates.erase(next);
+		auto &read_ahead = *candidate.read_ahead;
+		if (!read_ahead.StartHedge(*candidate.request)) {
+			continue;
+		}
+		running[&read_ahead]++;
+
+		guard.unlock();
+		try {
+			// Whichever request completes first populates the external file cache the scan reads the footer from
+			read_ahead.PrefetchFooter(candidate.file, candidate.file_size, candidate.tail_size);
+		} catch (std::exception &ex) {
+			// The primary request is still running, its error (if any) is the one that matters
+		}
+		guard.lock();
+		WorkFinished(read_ahead);
+	}
+}
+
+DeltaReadAhead::DeltaReadAhead(ClientContext &context, const DeltaMultiFileList &file_list_p, idx_t max_window_p)
+    : caching_file_system(CachingFileSystem::Get(context)), logger(context.logger),
+      pool(DeltaReadAheadPool::Get(context)), file_list(file_list_p), max_window(max_window_p) {
+	Value result;
+	if (context.TryGetCurrentSetting(HEDGE_BUDGET_SETTING_NAME, result)) {
+		hedge_budget = MinValue(MaxValue(result.GetValue<double>(), 0.0), 1.0);
+	}
+	if (context.TryGetCurrentSetting(HEDGE_PERCENTILE_SETTING_NAME, result)) {
+		hedge_percentile = MinValue(MaxValue(result.GetValue<double>(), 0.0), 1.0);
+	}
+}
+
+DeltaReadAhead::~DeltaReadAhead() {
+	pool->Remove(*this);
+}
+
+void DeltaReadAhead::ValidateHedgeSetting(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value = parameter.GetValue<double>();
+	if (!(value >= 0 && value <= 1)) {
+		throw InvalidInputException("The hedging settings of delta scans must be between 0 and 1, got %s",
+		                            parameter.ToString());
+	}
+}
+
+bool DeltaReadAhead::Enabled(ClientContext &context, const string &path, idx_t &max_window) {
+	Value result;
+	if (!context.TryGetCurrentSetting(SETTING_NAME, result)) {
+		return false;
+	}
+	max_window = result.GetValue<idx_t>();
+	// Local files are fast enough to open that prefetching their footers does not pay off
+	return max_window > 0 && FileSystem::IsRemoteFile(path);
+}
+
+idx_t DeltaReadAhead::ComputeWindow() const {
+	if (!have_open_time || open_interval_ema_ms <= 0 || latency_ema_ms <= 0) {
+		return MinValue<idx_t>(2, max_window);
+	}
+	// Read far enough ahead that a footer fetch started now completes before the scan gets to the file
+	auto files_in_flight = static_cast<idx_t>(latency_ema_ms / open_interval_ema_ms) + 1;
+	return MaxValue<idx_t>(1, MinValue<idx_t>(files_in_flight, max_window));
+}
+
+void DeltaReadAhead::FileOpened(idx_t file_idx) {
+	idx_t scheduled = 0;
+	{
+		lock_guard<mutex> guard(lock);
+		auto now = std::chrono::steady_clock::now();
+		if (have_open_time) {
+			double interval_ms = std::chrono::duration<double, std::milli>(now - last_open_time).count();
+			open_interval_ema_ms = open_interval_ema_ms == 0
+			                           ? interval_ms
+			                           : (1 - EMA_WEIGHT) * open_interval_ema_ms + EMA_WEIGHT * interval_ms;
+		}
+		have_open_time = true;
+		last_open_time = now;
+		max_opened_file_idx = MaxValue(max_opened_file_idx, file_idx);
+
+		if (files_exhausted) {
+			return;
+		}
+		next_file_idx = MaxValue(next_file_idx, file_idx + 1);
+		auto last_file_idx = file_idx + ComputeWindow();
+		while (next_file_idx <= last_file_idx) {
+			queue.push_back(next_file_idx++);
+			scheduled++;
+		}
+	}
+	for (idx_t i = 0; i < scheduled; i++) {
+		pool->Schedule(*this);
+	}
+}
+
+idx_t DeltaReadAhead::PrefetchFooter(const OpenFileInfo &file, idx_t file_size, idx_t tail_size) {
+	auto handle = caching_file_system.OpenFile(file, FileFlags::FILE_FLAGS_READ);
+
+	// Fetch the tail of the file, this normally contains the complete footer
+	auto read_size = MinValue<idx_t>(tail_size, file_size);
+	data_ptr_t buffer;
+	auto buffer_handle = handle->Read(buffer, read_size, file_size - read_size);
+	if (read_size < 8) {
+		return 0;
+	}
+
+	// The last 8 bytes are the footer length followed by the magic bytes
+	auto footer_size = static_cast<idx_t>(Load<uint32_t>(buffer + read_size - 8)) + 8;
+	if (footer_size > read_size && footer_size <= file_size) {
+		handle->Read(buffer, footer_size, file_size - footer_size);
+	}
+	return footer_size;
+}
+
+void DeltaReadAhead::RecordLatency(double latency_ms) {
+	lock_guard<mutex> guard(lock);
+	latency_ema_ms = latency_ema_ms == 0 ? latency_ms : (1 - EMA_WEIGHT) * latency_ema_ms + EMA_WEIGHT * latency_ms;
+	if (latency_samples.size() < LATENCY_SAMPLE_COUNT) {
+		latency_samples.push_back(latency_ms);
+	} else {
+		latency_samples[next_latency_sample] = latency_ms;
+		next_latency_sample = (next_latency_sample + 1) % LATENCY_SAMPLE_COUNT;
+	}
+}
+
+double DeltaReadAhead::GetHedgeThreshold() {
+	lock_guard<mutex> guard(lock);
+	total_requests++;
+	if (hedge_budget <= 0 || latency_samples.size() < MIN_LATENCY_SAMPLES) {
+		return -1;
+	}
+	// Requests that can not be hedged within the budget are not scheduled for hedging at all
+	if (static_cast<double>(hedged_requests + 1) > hedge_budget * static_cast<double>(total_requests)) {
+		return -1;
+	}
+	auto samples = latency_samples;
+	auto percentile_idx = MinValue<idx_t>(static_cast<idx_t>(hedge_percentile * static_cast<double>(samples.size())),
+	                                      samples.size() - 1);
+	std::nth_element(samples.begin(), samples.begin() + NumericCast<int64_t>(percentile_idx), samples.end());
+	return samples[percentile_idx];
+}
+
+bool DeltaReadAhead::StartHedge(DeltaPrefetchRequest &request) {
+	lock_guard<mutex> request_guard(request.lock);
+	if (request.finished) {
+		return false;
+	}
+	// The budget is checked again, as other candidates may have been hedged since this one was scheduled
+	lock_guard<mutex> stats_guard(lock);
+	if (static_cast<double>(hedged_requests + 1) > hedge_budget * static_cast<double>(total_requests)) {
+		return false;
+	}
+	hedged_requests++;
+	request.hedged = true;
+	return true;
+}
+
+idx_t DeltaReadAhead::FetchFooter(const OpenFileInfo &file, idx_t file_size, idx_t tail_size, bool &hedged) {
+	hedged = false;
+	auto hedge_threshold_ms = GetHedgeThreshold();
+	if (hedge_threshold_ms < 0) {
+		return PrefetchFooter(file, file_size, tail_size);
+	}
+
+	// The primary request runs on this thread, the hedge thread of the pool duplicates it if it does not complete in
+	// time
+	auto request = make_shared_ptr<DeltaPrefetchRequest>();
+	auto threshold = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	    std::chrono::duration<double, std::milli>(hedge_threshold_ms));
+	pool->ScheduleHedge(
+	    DeltaHedgeCandidate {this, std::chrono::steady_clock::now() + threshold, request, file, file_size, tail_size});
+
+	idx_t footer_size = 0;
+	ErrorData error;
+	try {
+		footer_size = PrefetchFooter(file, file_size, tail_size);
+	} catch (std::exception &ex) {
+		error = ErrorData(ex);
+	}
+	{
+		lock_guard<mutex> guard(request->lock);
+		request->finished = true;
+		hedged = request->hedged;
+	}
+	if (error.HasError()) {
+		error.Throw();
+	}
+	return footer_size;
+}
+
+void DeltaReadAhead::LogPrefetch(const OpenFileInfo &file, idx_t footer_size, double latency_ms, bool hedged) {
+	if (!logger->ShouldLog(LOG_TYPE, LogLevel::LOG_INFO)) {
+		return;
+	}
+	child_list_t<Value> struct_fields;
+	struct_fields.push_back({"path", Value(file.path)});
+	struct_fields.push_back({"footer_size", Value::BIGINT(NumericCast<int64_t>(footer_size))});
+	struct_fields.push_back({"latency_ms", Value::DOUBLE(latency_ms)});
+	struct_fields.push_back({"hedged", Value::BOOLEAN(hedged)});
+	logger->WriteLog(LOG_TYPE, LogLevel::LOG_INFO, Value::STRUCT(struct_fields).ToString());
+}
+
+void DeltaReadAhead::RunPrefetch() {
+	// A prefetch is scheduled per queued file, but the files are taken from the queue in order: files that do not need
+	// to be prefetched anymore are skipped, until one footer is fetched
+	while (true) {
+		idx_t file_idx;
+		idx_t current_tail_size;
+		{
+			lock_guard<mutex> guard(lock);
+			if (queue.empty()) {
+				return;
+			}
+			file_idx = queue.front();
+			queue.pop_front();
+			// The scan already got to this file: it has been (or is being) opened by the reader itself
+			if (file_idx <= max_opened_file_idx) {
+				continue;
+			}
+			current_tail_size = tail_size;
+		}
+
+		// Only files the scan has listed are prefetched: advancing the listing is left to the scan itself
+		idx_t file_size;
+		bool listing_finished;
+		auto file = file_list.GetListedFileWithSize(file_idx, file_size, listing_finished);
+		if (file.path.empty()) {
+			lock_guard<mutex> guard(lock);
+			if (listing_finished) {
+				files_exhausted = true;
+				queue.clear();
+			} else {
+				// Reschedule the unlisted files once the scan opens the next file
+				next_file_idx = MinValue(next_file_idx, file_idx);
+				queue.erase(std::remove_if(queue.begin(), queue.end(), [&](idx_t idx) { return idx >= file_idx; }),
+				            queue.end());
+			}
+			continue;
+		}
+		if (file_size == DConstants::INVALID_INDEX || file_size == 0) {
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		idx_t footer_size;
+		bool hedged;
+		try {
+			footer_size = FetchFooter(file, file_size, current_tail_size, hedged);
+		} catch (std::exception &ex) {
+			// Read-ahead is best effort: errors are reported when the scan itself gets to the file
+			continue;
+		}
+		auto latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		RecordLatency(latency_ms);
+		LogPrefetch(file, footer_size, latency_ms, hedged);
+
+		lock_guard<mutex> guard(lock);
+		tail_size = MinValue(MaxValue(tail_size, footer_size), MAX_TAIL_SIZE);
+		return;
+	}
+}
+
+} // namespace duckdb
@@ -1,10 +1,14 @@
 #include "delta_functions.hpp"
+#include "functions/delta_distinct_counts.hpp"
 #include "functions/delta_scan/delta_scan.hpp"
+#include "functions/delta_scan/delta_multi_file_list.hpp"
 #include "functions/delta_scan/delta_multi_file_reader.hpp"
 
 #include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
 #include "duckdb/main/extension_helper.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
 #include "duckdb/main/extension_util.hpp"
 #include "duckdb/main/query_profiler.hpp"
 #include "duckdb/main/secret/secret_manager.hpp"
@@ -26,6 +30,9 @@ DeltaFilterPushdownMode DeltaEnumUtils::FromString(const string &str) {
 	if (str_to_lower == "dynamic_only") {
 		return DeltaFilterPushdownMode::DYNAMIC_ONLY;
 	}
+	if (str_to_lower == "adaptive") {
+		return DeltaFilterPushdownMode::ADAPTIVE;
+	}
 	throw InvalidInputException("Unknown Filter pushdown mode: %s", str);
 }
 
@@ -39,11 +46,84 @@ string DeltaEnumUtils::ToString(const DeltaFilterPushdownMode &mode) {
 		return "dynamic_only";
 	case DeltaFilterPushdownMode::CONSTANT_ONLY:
 		return "constant_only";
+	case DeltaFilterPushdownMode::ADAPTIVE:
+		return "adaptive";
 	default:
 		throw InvalidInputException("Unknown delta pushdown mode: %s", mode);
 	}
 }
 
+void DeltaSnapshotRegistry::Register(const string &path, shared_ptr<DeltaMultiFileList> snapshot) {
+	lock_guard<mutex> guard(lock);
+	snapshots[path] = std::move(snapshot);
+}
+
+void DeltaSnapshotRegistry::Unregister(const string &path) {
+	lock_guard<mutex> guard(lock);
+	snapshots.erase(path);
+}
+
+shared_ptr<DeltaMultiFileList> DeltaSnapshotRegistry::Lookup(const string &path) {
+	lock_guard<mutex> guard(lock);
+	auto entry = snapshots.find(path);
+	if (entry == snapshots.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+unique_ptr<MaterializedQueryResult> DeltaSnapshotRegistry::Query(Connection &connection,
+                                                                 shared_ptr<DeltaMultiFileList> snapshot,
+                                                                 const string &query) {
+	auto path = snapshot->GetPath();
+	auto &context = *connection.context;
+	auto registry = context.registered_state->GetOrCreate<DeltaSnapshotRegistry>(DeltaSnapshotRegistry::NAME);
+	registry->Register(path, std::move(snapshot));
+
+	auto result = connection.Query(StringUtil::Replace(query, "{path}", Value(path).ToSQLString()));
+	registry->Unregister(path);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+	return result;
+}
+
+unique_ptr<MaterializedQueryResult> DeltaSnapshotRegistry::QueryFiles(Connection &connection,
+                                                                      DeltaMultiFileList &snapshot,
+                                                                      unordered_set<string> file_paths,
+                                                                      const string &query) {
+	shared_ptr<const unordered_set<string>> selection = make_shared_ptr<unordered_set<string>>(std::move(file_paths));
+	shared_ptr<DeltaMultiFileList> selected_snapshot = snapshot.SelectFiles(*connection.context, std::move(selection));
+	return Query(connection, std::move(selected_snapshot), query);
+}
+
+//! Reports the distinct counts computed by delta_analyze, loaded from the sidecar of the table if they were computed by
+//! another database. No other statistics are known before reading the files
+static unique_ptr<BaseStatistics> DeltaScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                      column_t column_index) {
+	auto &bind_data = bind_data_p->Cast<MultiFileBindData>();
+	if (column_index >= bind_data.names.size() || !bind_data.file_list) {
+		return nullptr;
+	}
+	auto &snapshot = bind_data.file_list->Cast<DeltaMultiFileList>();
+	auto distinct_count = DeltaDistinctCounts::GetDistinctCount(context, snapshot, bind_data.names[column_index]);
+	if (!distinct_count.IsValid()) {
+		return nullptr;
+	}
+	auto result = BaseStatistics::CreateUnknown(bind_data.types[column_index]);
+	result.SetDistinctCount(distinct_count.GetIndex());
+	return result.ToUnique();
+}
+
+static double DeltaScanProgress(ClientContext &context, const FunctionData *bind_data_p,
+                                const GlobalTableFunctionState *global_state) {
+	auto &gstate = global_state->Cast<MultiFileGlobalState>();
+	if (!gstate.multi_file_reader_state) {
+		return 0;
+	}
+	return gstate.multi_file_reader_state->Cast<DeltaMultiFileReaderGlobalState>().GetProgress(context);
+}
+
 static InsertionOrderPreservingMap<string> DeltaFunctionToString(TableFunctionToStringInput &input) {
 	InsertionOrderPreservingMap<string> result;
 
@@ -89,8 +169,8 @@ TableFunctionSet DeltaFunctions::GetDeltaScanFunction(DatabaseInstance &instance
 		// TODO: implement/fix these
 		function.serialize = nullptr;
 		function.deserialize = nullptr;
-		function.statistics = nullptr;
-		function.table_scan_progress = nullptr;
+		function.statistics = DeltaScanStatistics;
+		function.table_scan_progress = DeltaScanProgress;
 		function.get_bind_info = nullptr;
 		function.get_virtual_columns = DeltaVirtualColumns;
 		function.late_materialization = false;
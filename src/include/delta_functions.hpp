@@ -20,6 +20,11 @@ public:
 private:
 	//! Table Functions
 	static TableFunctionSet GetDeltaScanFunction(DatabaseInstance &instance);
+	static TableFunctionSet GetDeltaGenerateFunction(DatabaseInstance &instance);
+	static TableFunctionSet GetDeltaCachedQueryFunction(DatabaseInstance &instance);
+	static TableFunctionSet GetDeltaCreateAggregateViewFunction(DatabaseInstance &instance);
+	static TableFunctionSet GetDeltaRefreshAggregateViewFunction(DatabaseInstance &instance);
+	static TableFunctionSet GetDeltaAnalyzeFunction(DatabaseInstance &instance);
 
 	//! Scalar Functions
 	static ScalarFunctionSet GetExpressionFunction(DatabaseInstance &instance);
@@ -16,6 +16,7 @@
 
 namespace duckdb {
 class DatabaseInstance;
+class BufferManager;
 
 class ExpressionVisitor : public ffi::EngineExpressionVisitor {
 	using FieldList = vector<unique_ptr<ParsedExpression>>;
@@ -134,16 +135,31 @@ private:
 	unique_ptr<FieldList> TakeFieldList(uintptr_t id);
 };
 
+//! The parquet field id of a (nested) field of a Delta schema, NULL if the field has none
+struct DeltaFieldId {
+	Value id;
+	vector<DeltaFieldId> children;
+	//! The element of a list or the key or value of a map: these are identified by their position in the parent and
+	//! only carry a field id if the writer assigned one
+	bool collection_element = false;
+};
+
 // SchemaVisitor is used to parse the schema of a Delta table from the Kernel
 class SchemaVisitor {
 public:
 	using FieldList = child_list_t<LogicalType>;
+	using FieldIdList = vector<DeltaFieldId>;
 
 	static unique_ptr<FieldList> VisitSnapshotSchema(ffi::SharedSnapshot *snapshot);
-	static unique_ptr<FieldList> VisitSnapshotGlobalReadSchema(ffi::SharedScan *state, bool logical);
+	//! Visit the global read schema of a scan, optionally collecting the parquet field ids of the fields
+	static unique_ptr<FieldList> VisitSnapshotGlobalReadSchema(ffi::SharedScan *state, bool logical,
+	                                                           optional_ptr<FieldIdList> field_ids = nullptr);
 
 private:
 	unordered_map<uintptr_t, unique_ptr<FieldList>> inflight_lists;
+	//! The field ids of the inflight lists, only populated when capture_field_ids is set
+	unordered_map<uintptr_t, FieldIdList> inflight_field_ids;
+	bool capture_field_ids = false;
 	uintptr_t next_id = 1;
 
 	ErrorData error;
@@ -160,7 +176,7 @@ private:
 	template <LogicalTypeId TypeId>
 	static void VisitSimpleTypeImpl(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
 	                                bool is_nullable, const ffi::CStringMap *metadata) {
-		state->AppendToList(sibling_list_id, name, TypeId);
+		state->AppendToList(sibling_list_id, name, TypeId, metadata);
 	}
 
 	static void VisitDecimal(SchemaVisitor *state, uintptr_t sibling_list_id, ffi::KernelStringSlice name,
@@ -174,8 +190,11 @@ private:
 	                     const ffi::CStringMap *metadata, uintptr_t child_list_id);
 
 	uintptr_t MakeFieldListImpl(uintptr_t capacity_hint);
-	void AppendToList(uintptr_t id, ffi::KernelStringSlice name, LogicalType &&child);
+	void AppendToList(uintptr_t id, ffi::KernelStringSlice name, LogicalType &&child,
+	                  const ffi::CStringMap *metadata, FieldIdList child_field_ids = FieldIdList());
 	unique_ptr<FieldList> TakeFieldList(uintptr_t id);
+	FieldIdList TakeFieldIds(uintptr_t id);
+	static FieldIdList TakeCollectionFieldIds(SchemaVisitor &state, uintptr_t child_list_id);
 };
 
 // Allocator for errors that the kernel might throw
@@ -354,6 +373,32 @@ private:
 	uintptr_t VisitFilter(const string &col_name, const TableFilter &filter, ffi::KernelExpressionVisitorState *state);
 };
 
+//! Memory used by Delta metadata (file lists, deletion vectors), reserved from the buffer manager so it counts toward the
+//! memory limit and shows up under the EXTENSION tag of duckdb_memory(). Not thread-safe: owners synchronize resizes
+class DeltaMemoryReservation {
+public:
+	explicit DeltaMemoryReservation(BufferManager &buffer_manager);
+	~DeltaMemoryReservation();
+
+	// No copying pls
+	DeltaMemoryReservation(const DeltaMemoryReservation &) = delete;
+	DeltaMemoryReservation &operator=(const DeltaMemoryReservation &) = delete;
+
+	//! Set the used memory, throws an OutOfMemoryException if the memory limit is exceeded
+	void Resize(idx_t new_size);
+	idx_t GetSize() const {
+		return size;
+	}
+
+private:
+	//! Memory is reserved in blocks, so small metadata allocations do not each go through the buffer manager
+	static constexpr idx_t RESERVATION_GRANULARITY = 64 * 1024;
+
+	BufferManager &buffer_manager;
+	idx_t size = 0;
+	idx_t reserved = 0;
+};
+
 // Singleton class to forward logs to DuckDB
 class LoggerCallback {
 public:
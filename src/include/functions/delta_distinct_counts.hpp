@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// functions/delta_distinct_counts.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+namespace duckdb {
+
+class DeltaMultiFileList;
+
+//! The distinct counts of an analyzed table, reported by delta_cache_info
+struct DeltaDistinctCountsInfo {
+	string path;
+	idx_t version;
+	idx_t hits;
+	timestamp_t created;
+};
+
+//! The distinct counts of Delta table columns computed by delta_analyze, reported by the statistics of delta scans.
+//! Counts are kept for a single version of the table and only reported for scans of that version: the files of
+//! another version were not part of the merged sketches
+class DeltaDistinctCounts : public ObjectCacheEntry {
+public:
+	static shared_ptr<DeltaDistinctCounts> Get(ClientContext &context);
+
+	//! The distinct count of a column of the snapshot. On the first lookup of a version that was not analyzed in this
+	//! database, the sketches of the files of the snapshot are loaded from the sidecar of the table and merged. The
+	//! count is unknown if a file of the snapshot has no sketch for the column
+	static optional_idx GetDistinctCount(ClientContext &context, DeltaMultiFileList &snapshot, const string &column);
+
+	//! Analyzing another version of the table replaces the counts of the previous one
+	void Put(const string &path, idx_t version, const string &column, idx_t distinct_count);
+	optional_idx Lookup(const string &path, idx_t version, const string &column);
+	//! Whether counts are known for the version of the table, possibly none of the columns
+	bool HasVersion(const string &path, idx_t version);
+	//! Replace the counts of the table by those of the columns of the version
+	void PutVersion(const string &path, idx_t version, case_insensitive_map_t<idx_t> columns);
+	//! Drop the counts of all tables, or of the table at path (returning whether it had counts). The sketches in the
+	//! sidecars are kept, so analyzing the table again does not read its files
+	void Clear();
+	bool ClearTable(const string &path);
+
+	vector<DeltaDistinctCountsInfo> GetEntries();
+
+	static string ObjectType() {
+		return "delta_distinct_counts";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	//! The setting with the directory holding the sketches of analyzed files
+	static constexpr const char *DIRECTORY_SETTING_NAME = "delta_analyze_directory";
+
+private:
+	struct TableDistinctCounts {
+		idx_t version = DConstants::INVALID_INDEX;
+		case_insensitive_map_t<idx_t> columns;
+		//! The number of times the counts were reported to a scan
+		idx_t hits = 0;
+		timestamp_t created;
+	};
+
+	mutex lock;
+	unordered_map<string, TableDistinctCounts> distinct_counts;
+};
+
+} // namespace duckdb
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// functions/delta_query_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/set_scope.hpp"
+#include "duckdb/common/list.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/set.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+namespace duckdb {
+
+//! The result of a query, shared between the cache and the scans returning it
+struct DeltaCachedResult {
+	vector<string> names;
+	vector<LogicalType> types;
+	unique_ptr<ColumnDataCollection> collection;
+};
+
+//! A cached result, reported by delta_cache_info
+struct DeltaQueryCacheEntryInfo {
+	string query;
+	idx_t memory_usage;
+	idx_t hits;
+	timestamp_t created;
+};
+
+//! Cache of query results used by delta_cached_query. Results are keyed by the normalized query and the versions of
+//! the Delta tables it reads: since a Delta version is immutable, a result stays valid until a table advances. The
+//! cache is bounded by memory, evicting the least recently used results first
+class DeltaQueryCache : public ObjectCacheEntry {
+public:
+	static shared_ptr<DeltaQueryCache> Get(ClientContext &context);
+
+	shared_ptr<const DeltaCachedResult> Lookup(const string &key);
+	//! Insert the result of query under key, results of the same query for other versions are dropped. tables are
+	//! the Delta tables (catalog names or paths) the query reads
+	void Insert(const string &query, const string &key, set<string> tables, shared_ptr<const DeltaCachedResult> result,
+	            idx_t max_memory);
+	void Clear();
+	//! Drop the results of queries reading the Delta table with the given catalog name or path, returns whether any
+	//! results were dropped
+	bool ClearTable(const string &table);
+	//! Evict the least recently used results until the cache fits in max_memory
+	void Evict(idx_t max_memory);
+	//! Callback of the size setting: the new bound applies to the results that are already cached
+	static void ResizeOnSetting(ClientContext &context, SetScope scope, Value &parameter);
+
+	idx_t Count();
+	idx_t GetMemoryUsage();
+	vector<DeltaQueryCacheEntryInfo> GetEntries();
+
+	static string ObjectType() {
+		return "delta_query_cache";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	//! The setting bounding the memory of the cache
+	static constexpr const char *SETTING_NAME = "delta_query_cache_size";
+
+private:
+	struct CacheEntry {
+		string query;
+		set<string> tables;
+		shared_ptr<const DeltaCachedResult> result;
+		idx_t memory_usage;
+		list<string>::iterator lru_position;
+		idx_t hits;
+		timestamp_t created;
+	};
+
+	void Erase(const string &key);
+	void EvictInternal(idx_t max_memory);
+
+	mutex lock;
+	unordered_map<string, CacheEntry> entries;
+	//! The cached key of each query
+	unordered_map<string, string> query_keys;
+	//! Keys from most to least recently used
+	list<string> lru;
+	idx_t memory_usage = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// functions/delta_scan/delta_deletion_vector.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "delta_utils.hpp"
+
+#include "duckdb/common/types/selection_vector.hpp"
+
+namespace duckdb {
+
+//! The deletion vector of a data file, stored as a bitmask of the rows that are not deleted. Keeps the number of deleted
+//! rows per block of STANDARD_VECTOR_SIZE rows so blocks without deletes (or with only deletes) are filtered without
+//! visiting every row
+class DeltaDeletionVector {
+public:
+	//! Converts the kernel selection vector (one byte per row) into a bitmask and frees it
+	explicit DeltaDeletionVector(ffi::KernelBoolSlice selection_vector);
+
+	// No copying pls
+	DeltaDeletionVector(const DeltaDeletionVector &) = delete;
+	DeltaDeletionVector &operator=(const DeltaDeletionVector &) = delete;
+
+public:
+	//! Total number of deleted rows
+	idx_t DeletedCount() const {
+		return deleted_count;
+	}
+	//! Hash of the indexes of the deleted rows, together with the count this identifies the deleted rows
+	hash_t DeletedRowsHash() const {
+		return deleted_rows_hash;
+	}
+	//! Whether all rows of a file with file_row_count rows are deleted
+	bool AllRowsDeleted(idx_t file_row_count) const;
+	//! Write the rows in [start_row_index, start_row_index + count) that are not deleted to result_sel
+	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) const;
+	//! The number of bytes used by the deletion vector
+	idx_t GetMemoryUsage() const;
+
+private:
+	//! Number of deleted rows in [start, end)
+	idx_t DeletedInRange(idx_t start, idx_t end) const;
+	bool IsSelected(idx_t row_idx) const {
+		return row_idx >= row_count || (valid_mask[row_idx / 64] >> (row_idx % 64)) & 1;
+	}
+
+private:
+	//! The number of rows covered by the deletion vector, rows past it are never deleted
+	idx_t row_count = 0;
+	vector<uint64_t> valid_mask;
+	idx_t deleted_count = 0;
+	hash_t deleted_rows_hash = 0;
+	//! Number of deleted rows per block of STANDARD_VECTOR_SIZE rows
+	vector<idx_t> deleted_per_block;
+};
+
+//! The deletion vectors of the files of one snapshot, keyed by data file path. This is shared by all file lists
+//! created for the snapshot so that every deletion vector is only fetched through the kernel once
+class DeltaDeletionVectorCache {
+public:
+	explicit DeltaDeletionVectorCache(BufferManager &buffer_manager);
+
+	shared_ptr<const DeltaDeletionVector> Get(const string &path);
+	void Put(const string &path, shared_ptr<const DeltaDeletionVector> deletion_vector);
+
+	idx_t Count();
+	idx_t GetMemoryUsage();
+
+private:
+	mutex lock;
+	unordered_map<string, shared_ptr<const DeltaDeletionVector>> deletion_vectors;
+	//! The memory of the cached deletion vectors
+	DeltaMemoryReservation memory_reservation;
+};
+
+} // namespace duckdb
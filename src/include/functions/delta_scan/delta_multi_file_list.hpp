@@ -9,8 +9,10 @@
 #pragma once
 
 #include "delta_utils.hpp"
+#include "functions/delta_scan/delta_deletion_vector.hpp"
 #include "functions/delta_scan/delta_multi_file_list.hpp"
 
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
 #include "duckdb/common/multi_file/multi_file_data.hpp"
 
@@ -23,22 +25,29 @@ struct DeltaFileMetaData {
 	DeltaFileMetaData(const DeltaFileMetaData &) = delete;
 	DeltaFileMetaData &operator=(const DeltaFileMetaData &) = delete;
 
-	~DeltaFileMetaData() {
-		if (selection_vector.ptr) {
-			ffi::free_bool_slice(selection_vector);
-		}
-	}
-
 	idx_t delta_snapshot_version = DConstants::INVALID_INDEX;
 	idx_t file_number = DConstants::INVALID_INDEX;
 	idx_t cardinality = DConstants::INVALID_INDEX;
-	ffi::KernelBoolSlice selection_vector = {nullptr, 0};
+	idx_t file_size = DConstants::INVALID_INDEX;
+	//! The deletion vector of the file, shared with the delete filters of the readers
+	shared_ptr<const DeltaDeletionVector> deletion_vector;
 
 	case_insensitive_map_t<Value> partition_map;
 
+	//! The kernel transform from the physical to the logical schema: a struct_pack with one child per logical column
 	unique_ptr<vector<unique_ptr<ParsedExpression>>> transform_expression;
 };
 
+//! The physical schema of a Delta table, aligned with the logical columns. Partition columns keep their logical name
+struct DeltaPhysicalSchema {
+	vector<string> names;
+	vector<LogicalType> types;
+	//! The parquet field ids, only set if map_by_field_id
+	SchemaVisitor::FieldIdList field_ids;
+	//! Whether the columns are identified by parquet field id (column mapping mode 'id')
+	bool map_by_field_id = false;
+};
+
 //! The DeltaMultiFileList implements the MultiFileList API to allow injecting it into the regular DuckDB parquet scan
 class DeltaMultiFileList : public MultiFileList {
 	friend struct ScanDataCallBack;
@@ -62,16 +71,37 @@ public:
 	                                                TableFilterSet &filters) const override;
 
 	unique_ptr<DeltaMultiFileList> PushdownInternal(ClientContext &context, TableFilterSet &new_filters) const;
+	//! Create a list over the same snapshot that only contains the files in file_paths
+	unique_ptr<DeltaMultiFileList> SelectFiles(ClientContext &context,
+	                                           shared_ptr<const unordered_set<string>> file_paths) const;
 
 	vector<OpenFileInfo> GetAllFiles() override;
 	FileExpandResult GetExpandResult() override;
 	idx_t GetTotalFileCount() override;
 	unique_ptr<NodeStatistics> GetCardinality(ClientContext &context) override;
 	DeltaFileMetaData &GetMetaData(idx_t index) const;
+	//! Get the i-th file and its size if it was listed already, returns an empty path otherwise. This never advances
+	//! the listing, so it is safe to call from threads other than the ones of the scan
+	OpenFileInfo GetListedFileWithSize(idx_t i, idx_t &file_size, bool &listing_finished) const;
+	//! The total size of the files listed so far, listing_finished is set if all files were listed
+	idx_t GetListedBytes(bool &listing_finished) const;
+	//! The memory held by the file list and the deletion vectors read for it
+	idx_t GetMemoryUsage() const;
 	idx_t GetVersion();
+	//! Whether the list holds a subset of the files of the snapshot: filters were pushed into it, or files selected
+	bool IsFiltered() const;
 	vector<string> GetPartitionColumns();
-
-	vector<MultiFileColumnDefinition> &GetLazyLoadedGlobalColumns() const;
+	//! The paths of all files with a signature of the rows deleted by their deletion vector (0 without one). The
+	//! kernel does not expose the deletion vector descriptor, so the signature is computed from the deleted rows
+	unordered_map<string, hash_t> GetFileSignatures();
+
+	//! The global column definitions containing the proper column identifiers, these are only fully constructed for
+	//! the columns in column_ids
+	vector<MultiFileColumnDefinition> GetGlobalColumns(const vector<ColumnIndex> &column_ids) const;
+	//! The physical (file) names of the global columns, partition columns keep their logical name
+	const vector<string> &GetPhysicalColumnNames() const;
+	//! Whether the global columns are identified by parquet field id (column mapping mode 'id')
+	bool MapByFieldId() const;
 
 protected:
 	//! Get the i-th expanded file
@@ -86,8 +116,17 @@ protected:
 	void EnsureSnapshotInitialized() const;
 	void EnsureScanInitialized() const;
 
-	void ReportFilterPushdown(ClientContext &context, DeltaMultiFileList &new_list, const vector<column_t> &column_ids,
-	                          const char *log_type, optional_ptr<MultiFilePushdownInfo> mfr_info) const;
+	//! Report a pushdown decision, new_list is not set if the filters were not pushed down
+	void ReportFilterPushdown(ClientContext &context, optional_ptr<DeltaMultiFileList> new_list,
+	                          const vector<column_t> &column_ids, const char *log_type,
+	                          optional_ptr<MultiFilePushdownInfo> mfr_info, const string &decision) const;
+	//! The filters on partition columns, these can be checked against the partition values of the files
+	vector<pair<string, reference<TableFilter>>> GetPartitionFilters(const TableFilterSet &filters) const;
+	//! Estimate the fraction of files pruned by filters from the partition values of the files listed so far. Returns
+	//! false if there is no estimate: no files were listed or none of the filters is on a partition column
+	bool EstimatePrunedFiles(const TableFilterSet &filters, double &pruned_fraction) const;
+	//! Whether the adaptive pushdown mode pushes down filters, decision describes why
+	bool AdaptivePushdown(ClientContext &context, const TableFilterSet &filters, string &decision) const;
 
 	template <class T>
 	T TryUnpackKernelResult(ffi::ExternResult<T> result) const {
@@ -107,6 +146,8 @@ protected:
 
 	//! Delta Kernel Structures
 	mutable shared_ptr<SharedKernelSnapshot> snapshot;
+	//! The deletion vectors of the snapshot, shared with all lists using the same snapshot
+	mutable shared_ptr<DeltaDeletionVectorCache> deletion_vector_cache;
 	mutable KernelExternEngine extern_engine;
 	mutable KernelScan scan;
 	mutable KernelScanDataIterator scan_data_iterator;
@@ -124,9 +165,13 @@ protected:
 
 	//! Metadata map for files
 	mutable vector<unique_ptr<DeltaFileMetaData>> metadata;
+	//! The memory used by the listed files, reserved from the buffer manager
+	mutable unique_ptr<DeltaMemoryReservation> metadata_reservation;
 
 	mutable vector<OpenFileInfo> resolved_files;
 	mutable TableFilterSet table_filters;
+	//! If set, only the files with these paths are part of the list
+	shared_ptr<const unordered_set<string>> file_selection;
 
 	//! Names
 	vector<string> names;
@@ -136,9 +181,8 @@ protected:
 
 	ClientContext &context;
 
-	// The schema containing the proper column identifiers, lazily loaded to avoid prematurely initializing the kernel
-	// scan
-	mutable vector<MultiFileColumnDefinition> lazy_loaded_schema;
+	// The physical schema, lazily loaded to avoid prematurely initializing the kernel scan
+	mutable shared_ptr<const DeltaPhysicalSchema> physical_schema;
 };
 
 // Callback for the ffi::kernel_scan_data_next callback
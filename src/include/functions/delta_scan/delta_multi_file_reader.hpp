@@ -9,18 +9,83 @@
 #pragma once
 
 #include "delta_utils.hpp"
+#include "functions/delta_scan/delta_read_ahead.hpp"
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
 #include "duckdb/common/multi_file/multi_file_data.hpp"
 #include "duckdb/common/multi_file/multi_file_states.hpp"
+#include "duckdb/common/multi_file/base_file_reader.hpp"
 
 namespace duckdb {
 
 class DeltaMultiFileList;
 
+//! The result of CreateMapping for one physical file schema, reused for all files sharing that schema
+struct DeltaSchemaMapping {
+	decltype(BaseFileReader::column_ids) column_ids;
+	decltype(BaseFileReader::column_indexes) column_indexes;
+	decltype(BaseFileReader::expression_map) expression_map;
+	unique_ptr<TableFilterSet> filters;
+	vector<unique_ptr<Expression>> expressions;
+	//! Per constant column, the position of the constant in its expression that holds the value of the file
+	unordered_map<idx_t, vector<idx_t>> constant_paths;
+};
+
 struct DeltaMultiFileReaderGlobalState : public MultiFileReaderGlobalState {
 	DeltaMultiFileReaderGlobalState(vector<LogicalType> extra_columns_p, optional_ptr<const MultiFileList> file_list_p)
 	    : MultiFileReaderGlobalState(extra_columns_p, file_list_p) {
 	}
+
+	//! Returns the global column definitions (with column identifiers) of the scan, these are built once per scan
+	const vector<MultiFileColumnDefinition> &GetGlobalColumns(const DeltaMultiFileList &snapshot,
+	                                                          const vector<MultiFileColumnDefinition> &global_columns,
+	                                                          const vector<ColumnIndex> &global_column_ids);
+	//! Returns the bind data to create the column mappings with, this switches to field id based mapping for tables
+	//! using column mapping mode 'id'
+	const MultiFileReaderBindData &GetReaderBindData(const DeltaMultiFileList &snapshot,
+	                                                 const MultiFileReaderBindData &bind_data);
+
+	//! Binds a kernel transform expression over the physical columns with the types they have in the file. Column
+	//! references are bound as BoundReferenceExpressions to the global column index. Returns nullptr if the transform
+	//! can not be bound
+	unique_ptr<Expression> BindTransformExpression(ClientContext &context, const vector<string> &physical_names,
+	                                               const vector<LogicalType> &physical_types,
+	                                               const ParsedExpression &transform);
+
+	shared_ptr<DeltaSchemaMapping> GetSchemaMapping(const string &fingerprint);
+	void AddSchemaMapping(const string &fingerprint, shared_ptr<DeltaSchemaMapping> mapping);
+
+	//! Prefetches the footers of the upcoming files, only set for remote tables with read-ahead enabled
+	unique_ptr<DeltaReadAhead> read_ahead;
+
+	//! Register a file of which reading started, to report the progress of the scan
+	void FileStarted(const shared_ptr<BaseFileReader> &reader, idx_t file_size);
+	//! The progress of the scan in percent: the bytes read of the files over the total size of the listed files.
+	//! Never decreases, and only reaches 100 once all files are listed
+	double GetProgress(ClientContext &context) const;
+
+protected:
+	mutex lock;
+	//! The global columns to map against: the snapshot schema, extended with the extra (virtual) columns
+	bool initialized_global_columns = false;
+	vector<MultiFileColumnDefinition> scan_global_columns;
+	//! Copy of the bind data with the mapping mode set to BY_FIELD_ID
+	unique_ptr<MultiFileReaderBindData> field_id_bind_data;
+	//! Column mappings keyed by the fingerprint of the physical file schema
+	unordered_map<string, shared_ptr<DeltaSchemaMapping>> schema_mappings;
+	//! Bound transform expressions, keyed by the transform expression string and the physical types
+	unordered_map<string, unique_ptr<Expression>> transform_expressions;
+
+	mutable mutex progress_lock;
+	//! The size of the files that were read completely, or skipped
+	mutable idx_t completed_bytes = 0;
+	//! The files that are being read, a file is complete once its reader is destroyed
+	mutable vector<pair<weak_ptr<BaseFileReader>, idx_t>> open_files;
+	//! The total size of the files, once all files are listed
+	mutable optional_idx total_bytes;
+	//! The highest progress reported so far, progress never goes back
+	mutable double reported_progress = 0;
+	//! The number of times the progress was requested, numbers the progress log entries of the changed progress
+	mutable idx_t progress_polls = 0;
 };
 
 struct DeltaMultiFileReader : public MultiFileReader {
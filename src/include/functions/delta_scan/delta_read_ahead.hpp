@@ -0,0 +1,188 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// functions/delta_scan/delta_read_ahead.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/set_scope.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/open_file_info.hpp"
+#include "duckdb/storage/caching_file_system.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace duckdb {
+
+class ClientContext;
+class DeltaMultiFileList;
+class DeltaReadAhead;
+class Logger;
+
+//! A footer prefetch, of which the primary request is executed by a worker of the read-ahead pool
+struct DeltaPrefetchRequest {
+	mutex lock;
+	//! Whether the primary request completed, after which the request is not hedged anymore
+	bool finished = false;
+	//! Whether a duplicate request was issued
+	bool hedged = false;
+};
+
+//! A prefetch that is hedged if its primary request did not complete before the deadline
+struct DeltaHedgeCandidate {
+	DeltaReadAhead *read_ahead;
+	std::chrono::steady_clock::time_point deadline;
+	shared_ptr<DeltaPrefetchRequest> request;
+	OpenFileInfo file;
+	idx_t file_size;
+	idx_t tail_size;
+};
+
+//! The threads issuing the footer requests of the read-ahead of all delta scans of a database. Footer reads are
+//! blocking remote requests: running them as tasks of the TaskScheduler would take the threads the scans themselves
+//! run on, and the prefetches would only run once the scheduler has idle threads, when the scan does not need them.
+//! The pool is shared by all scans so the number of threads is bounded per database rather than per scan: at most
+//! MAX_THREADS workers and a single thread issuing the hedged requests, started when first needed
+class DeltaReadAheadPool : public ObjectCacheEntry {
+public:
+	~DeltaReadAheadPool() override;
+
+	static shared_ptr<DeltaReadAheadPool> Get(ClientContext &context);
+
+	//! Schedule a prefetch of the read-ahead, executed by a worker running DeltaReadAhead::RunPrefetch
+	void Schedule(DeltaReadAhead &read_ahead);
+	//! Schedule a duplicate request, issued if the primary request did not complete before the deadline
+	void ScheduleHedge(DeltaHedgeCandidate candidate);
+	//! Drop the scheduled work of the read-ahead, and wait for its work that is running to complete
+	void Remove(DeltaReadAhead &read_ahead);
+
+	static string ObjectType() {
+		return "delta_read_ahead_pool";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+private:
+	void Worker();
+	void HedgeWorker();
+	//! Register that work of the read-ahead completed, waking up a pending Remove
+	void WorkFinished(DeltaReadAhead &read_ahead);
+
+private:
+	//! Number of threads issuing the primary requests
+	static constexpr idx_t MAX_THREADS = 4;
+
+	mutex lock;
+	std::condition_variable cv;
+	//! Notified when the running work of a read-ahead completes
+	std::condition_variable finished_cv;
+	bool shutdown = false;
+	vector<std::thread> threads;
+	//! One entry per scheduled prefetch, in the order they were scheduled by all scans
+	std::deque<DeltaReadAhead *> pending;
+	//! The number of requests running per read-ahead
+	unordered_map<DeltaReadAhead *, idx_t> running;
+
+	std::condition_variable hedge_cv;
+	std::thread hedge_thread;
+	vector<DeltaHedgeCandidate> hedge_candidates;
+};
+
+//! Prefetches the parquet footers of the files a delta scan will open next into DuckDB's external file cache, so that
+//! opening a reader does not have to wait for the footer to be fetched from remote storage. The number of files read
+//! ahead is adapted to the latency of the footer reads relative to the rate at which the scan opens files.
+//! Optionally, footer reads that take longer than a percentile of the observed latencies are hedged: a duplicate
+//! request is issued and the first response is used, limited to a budget relative to the number of requests
+class DeltaReadAhead {
+public:
+	DeltaReadAhead(ClientContext &context, const DeltaMultiFileList &file_list, idx_t max_window);
+	~DeltaReadAhead();
+
+	//! Called when the scan opens the file with index file_idx, schedules the prefetches for the files after it
+	void FileOpened(idx_t file_idx);
+
+	//! The setting controlling the maximum number of files to read ahead (0 disables read-ahead)
+	static constexpr const char *SETTING_NAME = "delta_scan_read_ahead";
+	//! The setting controlling the fraction of additional (hedged) requests that may be issued (0 disables hedging)
+	static constexpr const char *HEDGE_BUDGET_SETTING_NAME = "delta_scan_hedge_budget";
+	//! The setting controlling the latency percentile after which a request is hedged
+	static constexpr const char *HEDGE_PERCENTILE_SETTING_NAME = "delta_scan_hedge_percentile";
+	//! Checks that a hedging setting is a fraction between 0 and 1
+	static void ValidateHedgeSetting(ClientContext &context, SetScope scope, Value &parameter);
+	//! Whether read-ahead should be used for the table at path
+	static bool Enabled(ClientContext &context, const string &path, idx_t &max_window);
+	//! The log type of the prefetched footers
+	static constexpr const char *LOG_TYPE = "delta.ReadAhead";
+
+private:
+	friend class DeltaReadAheadPool;
+
+	//! Prefetches the footer of the next queued file, called by a worker of the pool
+	void RunPrefetch();
+	//! Reads the footer of the file through the caching file system, returns the size of the footer
+	idx_t PrefetchFooter(const OpenFileInfo &file, idx_t file_size, idx_t tail_size);
+	//! Reads the footer, scheduling a duplicate request on the hedge thread of the pool if it takes too long
+	idx_t FetchFooter(const OpenFileInfo &file, idx_t file_size, idx_t tail_size, bool &hedged);
+	//! Whether the request should be hedged now: it did not complete yet and the budget allows it
+	bool StartHedge(DeltaPrefetchRequest &request);
+	//! Returns the latency after which the current request should be hedged, or -1 if it should not be
+	double GetHedgeThreshold();
+	void RecordLatency(double latency_ms);
+	void LogPrefetch(const OpenFileInfo &file, idx_t footer_size, double latency_ms, bool hedged);
+	idx_t ComputeWindow() const;
+
+private:
+	//! Initial number of bytes fetched from the end of the file, grown to the largest footer seen
+	static constexpr idx_t DEFAULT_TAIL_SIZE = 64 * 1024;
+	static constexpr idx_t MAX_TAIL_SIZE = 16 * 1024 * 1024;
+	//! Weight of a new observation in the moving averages
+	static constexpr double EMA_WEIGHT = 0.2;
+	//! Number of latencies the hedging percentile is computed over, and the minimum number before hedging
+	static constexpr idx_t LATENCY_SAMPLE_COUNT = 128;
+	static constexpr idx_t MIN_LATENCY_SAMPLES = 16;
+
+	//! Resolved on construction: the threads of the pool do not use the client context themselves
+	CachingFileSystem caching_file_system;
+	shared_ptr<Logger> logger;
+	shared_ptr<DeltaReadAheadPool> pool;
+	const DeltaMultiFileList &file_list;
+	idx_t max_window;
+
+	mutex lock;
+	//! The files to prefetch, a prefetch is scheduled on the pool for every file queued
+	std::deque<idx_t> queue;
+
+	//! The next file that is not yet scheduled for read-ahead
+	idx_t next_file_idx = 0;
+	//! The highest file index opened by the scan: files below it do not need to be prefetched anymore
+	idx_t max_opened_file_idx = 0;
+	bool files_exhausted = false;
+
+	//! Exponential moving averages of the footer read latency and the time between two files being opened
+	double latency_ema_ms = 0;
+	double open_interval_ema_ms = 0;
+	bool have_open_time = false;
+	std::chrono::steady_clock::time_point last_open_time;
+	idx_t tail_size = DEFAULT_TAIL_SIZE;
+
+	//! Hedging configuration and state
+	double hedge_budget = 0;
+	double hedge_percentile = 0.95;
+	vector<double> latency_samples;
+	idx_t next_latency_sample = 0;
+	idx_t total_requests = 0;
+	idx_t hedged_requests = 0;
+};
+
+} // namespace duckdb
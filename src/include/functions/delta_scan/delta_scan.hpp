@@ -10,18 +10,26 @@
 
 #include "delta_utils.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/client_context_state.hpp"
 
 namespace duckdb {
+class Connection;
 class DeltaMultiFileList;
+class MaterializedQueryResult;
 
 enum class DeltaFilterPushdownMode : uint8_t {
 	NONE = 0,
 	ALL = 1,
 	CONSTANT_ONLY = 2,
 	DYNAMIC_ONLY = 3,
+	//! Push down filters only when they are expected to prune enough files to be worth listing the files again
+	ADAPTIVE = 4,
 };
 
 static constexpr DeltaFilterPushdownMode DEFAULT_PUSHDOWN_MODE = DeltaFilterPushdownMode::ALL;
+//! The minimum fraction of files the adaptive pushdown mode expects filters to prune before pushing them down
+static constexpr const char *ADAPTIVE_PUSHDOWN_THRESHOLD_SETTING = "delta_scan_adaptive_pushdown_threshold";
 
 struct DeltaEnumUtils {
 	static DeltaFilterPushdownMode FromString(const string &str);
@@ -34,4 +42,26 @@ struct DeltaFunctionInfo : public TableFunctionInfo {
 	string table_name;
 };
 
+//! Snapshots registered on a client context: delta_scan calls for a registered path read the registered snapshot
+//! instead of loading the latest one
+class DeltaSnapshotRegistry : public ClientContextState {
+public:
+	static constexpr const char *NAME = "delta_snapshot_registry";
+
+	void Register(const string &path, shared_ptr<DeltaMultiFileList> snapshot);
+	void Unregister(const string &path);
+	shared_ptr<DeltaMultiFileList> Lookup(const string &path);
+
+	//! Run query on connection with the snapshot registered, '{path}' in the query is replaced by its path
+	static unique_ptr<MaterializedQueryResult> Query(Connection &connection, shared_ptr<DeltaMultiFileList> snapshot,
+	                                                 const string &query);
+	//! Run query on connection with delta_scan reading only the files in file_paths of snapshot
+	static unique_ptr<MaterializedQueryResult> QueryFiles(Connection &connection, DeltaMultiFileList &snapshot,
+	                                                      unordered_set<string> file_paths, const string &query);
+
+private:
+	mutex lock;
+	unordered_map<string, shared_ptr<DeltaMultiFileList>> snapshots;
+};
+
 } // namespace duckdb
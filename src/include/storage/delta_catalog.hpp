@@ -16,12 +16,17 @@
 
 namespace duckdb {
 class DeltaSchemaEntry;
+class DeltaMaterializedTable;
+class DeltaLogWatcher;
 
 class DeltaClearCacheFunction : public TableFunction {
 public:
 	DeltaClearCacheFunction();
+};
 
-	static void ClearCacheOnSetting(ClientContext &context, SetScope scope, Value &parameter);
+class DeltaCacheInfoFunction : public TableFunction {
+public:
+	DeltaCacheInfoFunction();
 };
 
 class DeltaCatalog : public Catalog {
@@ -34,9 +39,14 @@ public:
 	bool use_cache;
 	bool pushdown_partition_info;
 	DeltaFilterPushdownMode filter_pushdown_mode;
+	//! If set, the table is materialized into DuckDB storage and scanned from there (ATTACH option MATERIALIZE)
+	unique_ptr<DeltaMaterializedTable> materialized_table;
+	//! If set, the snapshot is cached until a new commit is written to the log (ATTACH option WATCH_LOG)
+	unique_ptr<DeltaLogWatcher> log_watcher;
 
 public:
 	void Initialize(bool load_builtin) override;
+	void OnDetach(ClientContext &context) override;
 	string GetCatalogType() override {
 		return "delta";
 	}
@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/delta_log_watcher.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+
+//! Watches the _delta_log directory of a local Delta table (through inotify) and counts the commits written to it.
+//! Snapshots loaded at the same generation are up to date, so checking for a new version costs a single non-blocking
+//! read until a writer adds a commit
+class DeltaLogWatcher {
+public:
+	explicit DeltaLogWatcher(const string &table_path);
+	~DeltaLogWatcher();
+
+	//! Watching is only supported on Linux, elsewhere a snapshot is loaded for every transaction instead
+	static bool IsSupported();
+
+	//! Changes whenever a commit or checkpoint is written to the log
+	idx_t GetGeneration();
+
+private:
+	static bool IsLogFile(const char *name);
+
+	mutex lock;
+	idx_t generation = 0;
+	int inotify_fd = -1;
+};
+
+} // namespace duckdb
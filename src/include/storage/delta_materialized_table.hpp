@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/delta_materialized_table.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/connection.hpp"
+
+namespace duckdb {
+class DeltaMultiFileList;
+class TableCatalogEntry;
+
+//! A copy of an attached Delta table in a DuckDB in-memory database, which is scanned instead of the parquet files.
+//! The copy is kept up to date with the snapshot being scanned: on a version change only the rows of removed files
+//! (or files with a changed deletion vector) are deleted, and only the rows of new (or changed) files are inserted.
+//! The copy only moves forward: snapshots older than the copy are scanned from the parquet files
+class DeltaMaterializedTable {
+public:
+	explicit DeltaMaterializedTable(const string &catalog_name);
+
+	//! Bring the copy up to date with the snapshot, returns the table to scan or nullptr if the copy is newer than the
+	//! snapshot. The transaction of the context sees the copy at exactly the version of the snapshot
+	optional_ptr<TableCatalogEntry> Refresh(ClientContext &context, DeltaMultiFileList &snapshot,
+	                                        const vector<string> &names, const vector<LogicalType> &types);
+	//! Detach the database holding the copy
+	void Detach(ClientContext &context);
+
+	//! The column of the copy that holds the path of the file a row was read from
+	static constexpr const char *FILE_COLUMN = "__delta_file";
+
+private:
+	void CreateTable(Connection &connection, DeltaMultiFileList &snapshot, const vector<string> &names,
+	                 const vector<LogicalType> &types);
+	void ApplyChanges(Connection &connection, DeltaMultiFileList &snapshot, unordered_map<string, hash_t> new_files);
+	string GetQualifiedTableName() const;
+
+private:
+	mutex lock;
+	string database_name;
+	string table_name;
+
+	//! The schema of the copy, the copy is recreated when the schema of the Delta table changes
+	bool created = false;
+	vector<string> names;
+	vector<LogicalType> types;
+
+	//! The version of the snapshot the copy reflects
+	idx_t version = DConstants::INVALID_INDEX;
+	//! The files in the copy, with the signature of their deletion vector
+	unordered_map<string, hash_t> files;
+};
+
+} // namespace duckdb
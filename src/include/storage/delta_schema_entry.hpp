@@ -9,12 +9,22 @@
 #pragma once
 
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 #include "storage/delta_table_entry.hpp"
 
 namespace duckdb {
 class DeltaTransaction;
 class DeltaCatalog;
 
+//! The state of the table cached by a schema, reported by delta_cache_info
+struct DeltaCachedTableInfo {
+	shared_ptr<DeltaTableEntry> table;
+	//! The number of lookups served by the cached table, and the number of lookups that (re)loaded it
+	idx_t hits = 0;
+	idx_t misses = 0;
+	timestamp_t cached_at;
+};
+
 class DeltaSchemaEntry : public SchemaCatalogEntry {
 public:
 	DeltaSchemaEntry(Catalog &catalog, CreateSchemaInfo &info);
@@ -41,14 +51,26 @@ public:
 	void DropEntry(ClientContext &context, DropInfo &info) override;
 	optional_ptr<CatalogEntry> LookupEntry(CatalogTransaction transaction, const EntryLookupInfo &lookup_info) override;
 
-	optional_ptr<DeltaTableEntry> GetCachedTable();
+	shared_ptr<DeltaTableEntry> GetCachedTable();
+	DeltaCachedTableInfo GetCachedTableInfo();
+	//! Drop the cached table, the next lookup loads the latest snapshot. Running transactions keep their snapshot
+	void ClearCachedTable();
 
 	unique_ptr<DeltaTableEntry> CreateTableEntry(ClientContext &context);
 
+private:
+	//! Caches a newly loaded table, lock must be held
+	void SetCachedTable(unique_ptr<DeltaTableEntry> table);
+
 private:
 	//! Delta tables may be cached in the SchemaEntry. Since the TableEntry holds the snapshot, this allows sharing a
 	//! snapshot between different scans.
-	unique_ptr<DeltaTableEntry> cached_table;
+	shared_ptr<DeltaTableEntry> cached_table;
+	//! The generation of the log watcher at which cached_table was loaded (ATTACH option WATCH_LOG)
+	idx_t cached_generation = 0;
+	idx_t cache_hits = 0;
+	idx_t cache_misses = 0;
+	timestamp_t cached_at;
 	mutex lock;
 };
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 
 namespace duckdb {
@@ -31,6 +32,17 @@ public:
 
 public:
 	shared_ptr<DeltaMultiFileList> snapshot;
+
+private:
+	//! Look up delta_scan and bind it to the snapshot
+	TableFunction BindScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data);
+
+private:
+	//! For entries cached across queries (PIN_SNAPSHOT or WATCH_LOG) the scan is bound once, every query gets a copy
+	//! of the bind data
+	mutex bind_lock;
+	unique_ptr<TableFunction> cached_scan_function;
+	unique_ptr<FunctionData> cached_bind_data;
 };
 
 } // namespace duckdb
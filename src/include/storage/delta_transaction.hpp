@@ -36,11 +36,15 @@ public:
 
 public:
 	optional_ptr<DeltaTableEntry> GetTableEntry();
+	//! The table entry of this transaction, to let another transaction read the same snapshot
+	shared_ptr<DeltaTableEntry> GetSharedTableEntry();
 	DeltaTableEntry &InitializeTableEntry(ClientContext &context, DeltaSchemaEntry &schema_entry);
+	//! Use a table entry shared with other transactions for the rest of this transaction
+	DeltaTableEntry &SetTableEntry(shared_ptr<DeltaTableEntry> entry);
 
 private:
 	mutex lock;
-	unique_ptr<DeltaTableEntry> table_entry;
+	shared_ptr<DeltaTableEntry> table_entry;
 
 	//	DeltaConnection connection;
 	DeltaTransactionState transaction_state;
@@ -1,10 +1,15 @@
 #include "storage/delta_catalog.hpp"
+#include "functions/delta_distinct_counts.hpp"
+#include "functions/delta_query_cache.hpp"
+#include "storage/delta_log_watcher.hpp"
+#include "storage/delta_materialized_table.hpp"
 #include "storage/delta_schema_entry.hpp"
 #include "storage/delta_transaction.hpp"
 #include "duckdb/storage/database_size.hpp"
 #include "duckdb/parser/parsed_data/drop_info.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/database_manager.hpp"
 
 #include "functions/delta_scan/delta_multi_file_list.hpp"
 
@@ -22,6 +27,12 @@ void DeltaCatalog::Initialize(bool load_builtin) {
 	main_schema = make_uniq<DeltaSchemaEntry>(*this, info);
 }
 
+void DeltaCatalog::OnDetach(ClientContext &context) {
+	if (materialized_table) {
+		materialized_table->Detach(context);
+	}
+}
+
 optional_ptr<CatalogEntry> DeltaCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) {
 	throw BinderException("Delta tables do not support creating new schemas");
 }
@@ -91,6 +102,158 @@ DatabaseSize DeltaCatalog::GetDatabaseSize(ClientContext &context) {
 	return size;
 }
 
+struct ClearCacheFunctionData : public TableFunctionData {
+	//! The catalog name or path of the table to clear, all Delta caches are cleared if empty
+	string table;
+};
+
+struct ClearCacheGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<FunctionData> ClearCacheBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ClearCacheFunctionData>();
+	if (!input.inputs.empty()) {
+		if (input.inputs[0].IsNull()) {
+			throw BinderException("delta_clear_cache requires a table name or path, or no arguments");
+		}
+		result->table = input.inputs[0].GetValue<string>();
+	}
+	return_types.push_back(LogicalType::BOOLEAN);
+	names.emplace_back("Success");
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> ClearCacheInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<ClearCacheGlobalState>();
+}
+
+//! Clear the caches of all Delta tables, or those of a single table. Returns false if a single table was given that is
+//! neither an attached Delta table nor a path with cached results or distinct counts
+static bool ClearDeltaCaches(ClientContext &context, const string &table) {
+	bool cleared = table.empty();
+	auto databases = DatabaseManager::Get(context).GetDatabases(context);
+	for (auto &db_ref : databases) {
+		auto &catalog = db_ref.get().GetCatalog();
+		if (!table.empty() && catalog.GetName() != table) {
+			continue;
+		}
+		if (catalog.GetCatalogType() != "delta") {
+			if (!table.empty()) {
+				throw InvalidInputException("Failed to clear the cache of '%s': not an attached Delta table", table);
+			}
+			continue;
+		}
+		auto &delta_catalog = catalog.Cast<DeltaCatalog>();
+		delta_catalog.GetMainSchema().ClearCachedTable();
+		if (!table.empty()) {
+			DeltaDistinctCounts::Get(context)->ClearTable(DeltaMultiFileList::ToDeltaPath(delta_catalog.GetDBPath()));
+			cleared = true;
+		}
+	}
+
+	auto query_cache = DeltaQueryCache::Get(context);
+	auto distinct_counts = DeltaDistinctCounts::Get(context);
+	if (table.empty()) {
+		query_cache->Clear();
+		distinct_counts->Clear();
+		return cleared;
+	}
+	// Results are keyed by the catalog name for attached tables, and by the path for delta_scan calls
+	cleared = query_cache->ClearTable(table) || cleared;
+	cleared = query_cache->ClearTable(DeltaMultiFileList::ToDeltaPath(table)) || cleared;
+	cleared = distinct_counts->ClearTable(DeltaMultiFileList::ToDeltaPath(table)) || cleared;
+	return cleared;
+}
+
+static void ClearCacheFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<ClearCacheFunctionData>();
+	auto &state = data_p.global_state->Cast<ClearCacheGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	output.SetCardinality(1);
+	output.SetValue(0, 0, Value::BOOLEAN(ClearDeltaCaches(context, data.table)));
+	state.finished = true;
+}
+
+DeltaClearCacheFunction::DeltaClearCacheFunction()
+    : TableFunction("delta_clear_cache", {}, ClearCacheFunction, ClearCacheBind, ClearCacheInit) {
+}
+
+struct CacheInfoGlobalState : public GlobalTableFunctionState {
+	vector<vector<Value>> rows;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> CacheInfoBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"cache_type", "name", "version", "memory_usage", "hits", "misses", "created"};
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT,   LogicalType::BIGINT,
+	                LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::TIMESTAMP};
+	return make_uniq<TableFunctionData>();
+}
+
+//! The rows are collected when the query is executed, so a prepared statement reports the current state of the caches
+static unique_ptr<GlobalTableFunctionState> CacheInfoInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<CacheInfoGlobalState>();
+	auto databases = DatabaseManager::Get(context).GetDatabases(context);
+	for (auto &db_ref : databases) {
+		auto &catalog = db_ref.get().GetCatalog();
+		if (catalog.GetCatalogType() != "delta") {
+			continue;
+		}
+		auto info = catalog.Cast<DeltaCatalog>().GetMainSchema().GetCachedTableInfo();
+		if (!info.table && info.misses == 0) {
+			continue;
+		}
+		// A cleared snapshot keeps its counters, so they can be compared across refreshes
+		Value version(LogicalType::BIGINT), memory_usage(LogicalType::BIGINT), created(LogicalType::TIMESTAMP);
+		if (info.table) {
+			version = Value::BIGINT(NumericCast<int64_t>(info.table->snapshot->GetVersion()));
+			memory_usage = Value::BIGINT(NumericCast<int64_t>(info.table->snapshot->GetMemoryUsage()));
+			created = Value::TIMESTAMP(info.cached_at);
+		}
+		result->rows.push_back({Value("snapshot"), Value(catalog.GetName()), version, memory_usage,
+		                        Value::BIGINT(NumericCast<int64_t>(info.hits)),
+		                        Value::BIGINT(NumericCast<int64_t>(info.misses)), created});
+	}
+
+	for (auto &entry : DeltaQueryCache::Get(context)->GetEntries()) {
+		result->rows.push_back({Value("query_result"), Value(entry.query), Value(LogicalType::BIGINT),
+		                        Value::BIGINT(NumericCast<int64_t>(entry.memory_usage)),
+		                        Value::BIGINT(NumericCast<int64_t>(entry.hits)), Value(LogicalType::BIGINT),
+		                        Value::TIMESTAMP(entry.created)});
+	}
+
+	// Distinct counts are small and only depend on the analyzed version, memory and misses are not tracked for them
+	for (auto &entry : DeltaDistinctCounts::Get(context)->GetEntries()) {
+		result->rows.push_back({Value("distinct_counts"), Value(entry.path),
+		                        Value::BIGINT(NumericCast<int64_t>(entry.version)), Value(LogicalType::BIGINT),
+		                        Value::BIGINT(NumericCast<int64_t>(entry.hits)), Value(LogicalType::BIGINT),
+		                        Value::TIMESTAMP(entry.created)});
+	}
+	return std::move(result);
+}
+
+static void CacheInfoFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<CacheInfoGlobalState>();
+	idx_t count = 0;
+	while (state.offset < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &row = state.rows[state.offset++];
+		for (idx_t col = 0; col < row.size(); col++) {
+			output.SetValue(col, count, row[col]);
+		}
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+DeltaCacheInfoFunction::DeltaCacheInfoFunction()
+    : TableFunction("delta_cache_info", {}, CacheInfoFunction, CacheInfoBind, CacheInfoInit) {
+}
+
 PhysicalOperator &DeltaCatalog::PlanInsert(ClientContext &context, PhysicalPlanGenerator &planner, LogicalInsert &op,
                                            optional_ptr<PhysicalOperator> plan) {
 	throw NotImplementedException("DeltaCatalog PlanInsert");
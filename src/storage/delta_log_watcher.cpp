@@ -0,0 +1,100 @@
+#include "storage/delta_log_watcher.hpp"
+
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+#ifdef __linux__
+
+bool DeltaLogWatcher::IsSupported() {
+	return true;
+}
+
+DeltaLogWatcher::DeltaLogWatcher(const string &table_path) {
+	auto path = DeltaMultiFileList::ToDuckDBPath(DeltaMultiFileList::ToDeltaPath(table_path));
+	if (FileSystem::IsRemoteFile(path)) {
+		throw BinderException("WATCH_LOG is only supported for Delta tables on the local file system");
+	}
+	auto log_path = path + "_delta_log";
+
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd < 0) {
+		throw IOException("Failed to initialize inotify: %s", strerror(errno));
+	}
+	// Commits are either renamed into place or written in place, in which case they are complete once closed
+	if (inotify_add_watch(inotify_fd, log_path.c_str(), IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF) < 0) {
+		auto error = strerror(errno);
+		close(inotify_fd);
+		throw IOException("Failed to watch the Delta log at '%s': %s", log_path, error);
+	}
+}
+
+DeltaLogWatcher::~DeltaLogWatcher() {
+	close(inotify_fd);
+}
+
+bool DeltaLogWatcher::IsLogFile(const char *name) {
+	// Commits (<version>.json) and checkpoints, temporary files of writers start with a dot
+	string file_name(name);
+	return !file_name.empty() && file_name[0] != '.' &&
+	       (StringUtil::EndsWith(file_name, ".json") || StringUtil::EndsWith(file_name, ".parquet"));
+}
+
+idx_t DeltaLogWatcher::GetGeneration() {
+	// The kernel queues the events when the writer closes or renames the commit, so draining them here means a commit
+	// that completed before this call is always seen, without a thread racing the next query
+	lock_guard<mutex> l(lock);
+	alignas(struct inotify_event) char buffer[4096];
+	while (true) {
+		auto length = read(inotify_fd, buffer, sizeof(buffer));
+		if (length <= 0) {
+			// EAGAIN once all events are drained
+			break;
+		}
+		for (char *ptr = buffer; ptr < buffer + length;) {
+			auto event = reinterpret_cast<const struct inotify_event *>(ptr);
+			// On overflow or removal of the log we can not tell what changed, so snapshots are always reloaded
+			if ((event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF)) || (event->len > 0 && IsLogFile(event->name))) {
+				generation++;
+			}
+			ptr += sizeof(struct inotify_event) + event->len;
+		}
+	}
+	return generation;
+}
+
+#else
+
+bool DeltaLogWatcher::IsSupported() {
+	return false;
+}
+
+DeltaLogWatcher::DeltaLogWatcher(const string &table_path) {
+	throw NotImplementedException("WATCH_LOG is only supported on Linux");
+}
+
+DeltaLogWatcher::~DeltaLogWatcher() {
+}
+
+bool DeltaLogWatcher::IsLogFile(const char *name) {
+	return false;
+}
+
+idx_t DeltaLogWatcher::GetGeneration() {
+	return 0;
+}
+
+#endif
+
+} // namespace duckdb
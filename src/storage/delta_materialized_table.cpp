@@ -0,0 +1,131 @@
+#include "storage/delta_materialized_table.hpp"
+
+#include "functions/delta_scan/delta_multi_file_list.hpp"
+#include "functions/delta_scan/delta_scan.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+namespace duckdb {
+
+DeltaMaterializedTable::DeltaMaterializedTable(const string &catalog_name)
+    : database_name("__delta_materialized_" + catalog_name), table_name(catalog_name) {
+}
+
+static void Execute(Connection &connection, const string &query) {
+	auto result = connection.Query(query);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+}
+
+string DeltaMaterializedTable::GetQualifiedTableName() const {
+	return KeywordHelper::WriteOptionallyQuoted(database_name) + "." + DEFAULT_SCHEMA + "." +
+	       KeywordHelper::WriteOptionallyQuoted(table_name);
+}
+
+void DeltaMaterializedTable::CreateTable(Connection &connection, DeltaMultiFileList &snapshot,
+                                         const vector<string> &names_p, const vector<LogicalType> &types_p) {
+	// The table is created from an empty scan, so that its columns match the columns of the scan exactly
+	auto create_query =
+	    StringUtil::Format("CREATE OR REPLACE TABLE %s AS SELECT * FROM delta_scan({path}, filename := %s)",
+	                       GetQualifiedTableName(), Value(FILE_COLUMN).ToSQLString());
+	DeltaSnapshotRegistry::QueryFiles(connection, snapshot, unordered_set<string>(), create_query);
+
+	created = true;
+	names = names_p;
+	types = types_p;
+	version = DConstants::INVALID_INDEX;
+	files.clear();
+}
+
+void DeltaMaterializedTable::ApplyChanges(Connection &connection, DeltaMultiFileList &snapshot,
+                                          unordered_map<string, hash_t> new_files) {
+	// A file whose deletion vector changed is replaced as a whole
+	unordered_set<string> removed_files;
+	for (auto &file : files) {
+		auto entry = new_files.find(file.first);
+		if (entry == new_files.end() || entry->second != file.second) {
+			removed_files.insert(file.first);
+		}
+	}
+	unordered_set<string> added_files;
+	for (auto &file : new_files) {
+		auto entry = files.find(file.first);
+		if (entry == files.end() || entry->second != file.second) {
+			added_files.insert(file.first);
+		}
+	}
+
+	connection.BeginTransaction();
+	try {
+		if (!removed_files.empty()) {
+			string file_list;
+			for (auto &file : removed_files) {
+				file_list += (file_list.empty() ? "" : ", ") + Value(file).ToSQLString();
+			}
+			Execute(connection, StringUtil::Format("DELETE FROM %s WHERE %s IN (%s)", GetQualifiedTableName(),
+			                                       FILE_COLUMN, file_list));
+		}
+		if (!added_files.empty()) {
+			auto insert_query = StringUtil::Format("INSERT INTO %s SELECT * FROM delta_scan({path}, filename := %s)",
+			                                       GetQualifiedTableName(), Value(FILE_COLUMN).ToSQLString());
+			DeltaSnapshotRegistry::QueryFiles(connection, snapshot, std::move(added_files), insert_query);
+		}
+		connection.Commit();
+	} catch (...) {
+		connection.Rollback();
+		throw;
+	}
+
+	files = std::move(new_files);
+}
+
+optional_ptr<TableCatalogEntry> DeltaMaterializedTable::Refresh(ClientContext &context, DeltaMultiFileList &snapshot,
+                                                                const vector<string> &names_p,
+                                                                const vector<LogicalType> &types_p) {
+	lock_guard<mutex> guard(lock);
+	auto snapshot_version = snapshot.GetVersion();
+	if (created && version != DConstants::INVALID_INDEX && snapshot_version < version) {
+		return nullptr;
+	}
+
+	// The copy is maintained through a separate connection. It is not kept around: it would keep the database alive
+	unique_ptr<Connection> connection;
+	if (!created || names != names_p || types != types_p) {
+		connection = make_uniq<Connection>(DatabaseInstance::GetDatabase(context));
+		Execute(*connection, StringUtil::Format("ATTACH IF NOT EXISTS ':memory:' AS %s",
+		                                        KeywordHelper::WriteOptionallyQuoted(database_name)));
+		CreateTable(*connection, snapshot, names_p, types_p);
+	}
+
+	if (snapshot_version != version) {
+		auto new_files = snapshot.GetFileSignatures();
+		if (!connection) {
+			connection = make_uniq<Connection>(DatabaseInstance::GetDatabase(context));
+		}
+		ApplyChanges(*connection, snapshot, std::move(new_files));
+		version = snapshot_version;
+	}
+
+	// Looking up the table starts the transaction of the context on the copy. This happens while holding the lock, so
+	// no other refresh can move the copy to a different version before the transaction sees it
+	return Catalog::GetEntry<TableCatalogEntry>(context, database_name, DEFAULT_SCHEMA, table_name);
+}
+
+void DeltaMaterializedTable::Detach(ClientContext &context) {
+	lock_guard<mutex> guard(lock);
+	if (!created) {
+		return;
+	}
+	DatabaseManager::Get(context).DetachDatabase(context, database_name, OnEntryNotFound::RETURN_NULL);
+	created = false;
+	files.clear();
+	version = DConstants::INVALID_INDEX;
+}
+
+} // namespace duckdb
@@ -5,6 +5,7 @@
 
 #include "delta_extension.hpp"
 
+#include "storage/delta_log_watcher.hpp"
 #include "storage/delta_table_entry.hpp"
 #include "storage/delta_transaction.hpp"
 #include "duckdb/parser/parsed_data/create_index_info.hpp"
@@ -159,12 +160,29 @@ optional_ptr<CatalogEntry> DeltaSchemaEntry::LookupEntry(CatalogTransaction tran
 			return *transaction_table_entry;
 		}
 
+		if (delta_catalog.log_watcher) {
+			// The cached snapshot is current as long as no commit was written to the log since it was loaded. The
+			// transaction keeps its entry alive, so it keeps reading the same snapshot after the cache is replaced
+			unique_lock<mutex> l(lock);
+			auto generation = delta_catalog.log_watcher->GetGeneration();
+			if (!cached_table || cached_generation != generation) {
+				SetCachedTable(CreateTableEntry(context));
+				cached_generation = generation;
+			} else {
+				cache_hits++;
+			}
+			return delta_transaction.SetTableEntry(cached_table);
+		}
+
 		if (delta_catalog.UseCachedSnapshot()) {
+			// The transaction holds on to the cached table, so that clearing the cache does not free it while in use
 			unique_lock<mutex> l(lock);
 			if (!cached_table) {
-				cached_table = CreateTableEntry(context);
+				SetCachedTable(CreateTableEntry(context));
+			} else {
+				cache_hits++;
 			}
-			return *cached_table;
+			return delta_transaction.SetTableEntry(cached_table);
 		}
 
 		return delta_transaction.InitializeTableEntry(context, *this);
@@ -172,12 +190,30 @@ optional_ptr<CatalogEntry> DeltaSchemaEntry::LookupEntry(CatalogTransaction tran
 	return nullptr;
 }
 
-optional_ptr<DeltaTableEntry> DeltaSchemaEntry::GetCachedTable() {
+void DeltaSchemaEntry::SetCachedTable(unique_ptr<DeltaTableEntry> table) {
+	cached_table = std::move(table);
+	cached_at = Timestamp::GetCurrentTimestamp();
+	cache_misses++;
+}
+
+shared_ptr<DeltaTableEntry> DeltaSchemaEntry::GetCachedTable() {
 	lock_guard<mutex> lck(lock);
-	if (cached_table) {
-		return *cached_table;
-	}
-	return nullptr;
+	return cached_table;
+}
+
+DeltaCachedTableInfo DeltaSchemaEntry::GetCachedTableInfo() {
+	lock_guard<mutex> lck(lock);
+	DeltaCachedTableInfo result;
+	result.table = cached_table;
+	result.hits = cache_hits;
+	result.misses = cache_misses;
+	result.cached_at = cached_at;
+	return result;
+}
+
+void DeltaSchemaEntry::ClearCachedTable() {
+	lock_guard<mutex> lck(lock);
+	cached_table.reset();
 }
 
 } // namespace duckdb
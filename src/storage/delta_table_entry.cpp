@@ -1,5 +1,8 @@
+#include "functions/delta_scan/delta_multi_file_reader.hpp"
 #include "functions/delta_scan/delta_scan.hpp"
 #include "storage/delta_catalog.hpp"
+#include "storage/delta_log_watcher.hpp"
+#include "storage/delta_materialized_table.hpp"
 #include "storage/delta_table_entry.hpp"
 
 #include "duckdb/storage/statistics/base_statistics.hpp"
@@ -29,11 +32,53 @@ void DeltaTableEntry::BindUpdateConstraints(Binder &binder, LogicalGet &, Logica
 }
 
 TableFunction DeltaTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
+	auto &delta_catalog = catalog.Cast<DeltaCatalog>();
+
+	// Materialized tables are brought up to date with the snapshot and scanned natively, unless the copy already
+	// reflects a newer version than the snapshot of this transaction
+	if (delta_catalog.materialized_table) {
+		vector<string> column_names;
+		vector<LogicalType> column_types;
+		for (auto &column : columns.Physical()) {
+			column_names.push_back(column.Name());
+			column_types.push_back(column.Type());
+		}
+		auto materialized_table =
+		    delta_catalog.materialized_table->Refresh(context, *snapshot, column_names, column_types);
+		if (materialized_table) {
+			return materialized_table->GetScanFunction(context, bind_data);
+		}
+	}
+
+	// Entries loaded per transaction are bound for every query anyway
+	if (!delta_catalog.UseCachedSnapshot() && !delta_catalog.log_watcher) {
+		return BindScanFunction(context, bind_data);
+	}
+
+	// The snapshot and the options of a cached entry do not change, so neither does the result of the bind
+	lock_guard<mutex> guard(bind_lock);
+	if (!cached_scan_function) {
+		unique_ptr<FunctionData> new_bind_data;
+		auto scan_function = BindScanFunction(context, new_bind_data);
+		cached_scan_function = make_uniq<TableFunction>(std::move(scan_function));
+		cached_bind_data = std::move(new_bind_data);
+	}
+	bind_data = cached_bind_data->Copy();
+	// Copying the bind data expands the file list into a plain list of paths: the copy shares the delta file list of
+	// the cached bind data instead, filter pushdown replaces the file list of the copy only. The reader is recreated
+	// from the function, so that it keeps the snapshot injected through the function info
+	auto &multi_file_data = bind_data->Cast<MultiFileBindData>();
+	multi_file_data.file_list = cached_bind_data->Cast<MultiFileBindData>().file_list;
+	multi_file_data.multi_file_reader = DeltaMultiFileReader::CreateInstance(*cached_scan_function);
+	return *cached_scan_function;
+}
+
+TableFunction DeltaTableEntry::BindScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
+	auto &delta_catalog = catalog.Cast<DeltaCatalog>();
 	auto &db = DatabaseInstance::GetDatabase(context);
 	auto &delta_function_set = ExtensionUtil::GetTableFunction(db, "delta_scan");
 
 	auto delta_scan_function = delta_function_set.functions.GetFunctionByArguments(context, {LogicalType::VARCHAR});
-	auto &delta_catalog = catalog.Cast<DeltaCatalog>();
 
 	// Copy over the internal kernel snapshot
 	auto function_info = make_shared_ptr<DeltaFunctionInfo>();
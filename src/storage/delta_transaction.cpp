@@ -44,6 +44,11 @@ optional_ptr<DeltaTableEntry> DeltaTransaction::GetTableEntry() {
 	return table_entry;
 }
 
+shared_ptr<DeltaTableEntry> DeltaTransaction::GetSharedTableEntry() {
+	unique_lock<mutex> lck(lock);
+	return table_entry;
+}
+
 DeltaTableEntry &DeltaTransaction::InitializeTableEntry(ClientContext &context, DeltaSchemaEntry &schema_entry) {
 	unique_lock<mutex> lck(lock);
 	if (!table_entry) {
@@ -52,4 +57,12 @@ DeltaTableEntry &DeltaTransaction::InitializeTableEntry(ClientContext &context,
 	return *table_entry;
 }
 
+DeltaTableEntry &DeltaTransaction::SetTableEntry(shared_ptr<DeltaTableEntry> entry) {
+	unique_lock<mutex> lck(lock);
+	if (!table_entry) {
+		table_entry = std::move(entry);
+	}
+	return *table_entry;
+}
+
 } // namespace duckdb